@@ -9,6 +9,10 @@ static ch9141_t *ble1 = &(ch9141_t) {.interface = {.delay = CH9141_Delay,
                                                    .transmit = CH9141_UART_Transmit}};
 static char paramSet[50] = {0};
 static char bleResponse[50] = {0};
+static ch9141_SerialCfg_t serial;
+static ch9141_Name_t name;
+static ch9141_MAC_t macLocal;
+static ch9141_MAC_t macRemote;
 static uint16_t vcc;
 static uint16_t adc;
 
@@ -23,10 +27,9 @@ void CH9141_Demo(void)
      */
     if (ble1->interface.pinReload != NULL)
     {
-        strcpy(paramSet, "9600,8,1,0,50");
         CH9141_SerialSet(ble1, 9600, 8, 1, CH9141_SERIAL_PARITY_NONE, 50); // OK
-        strncpy(bleResponse, CH9141_SerialGet(ble1), ble1->responseLen); // Won't response here because wrong baudrate
-        if (strcmp(bleResponse, paramSet) != 0) // No response received
+        CH9141_SerialGetEx(ble1, &serial); // Won't response here because wrong baudrate
+        if (ble1->error != CH9141_ERR_NONE) // No response received
         {
             /* Reinitialize the device with factory restore option */
             ble1->error = CH9141_ERR_NONE; // Reset existing `CH9141_ERR_SERIAL_RX` error
@@ -35,10 +38,9 @@ void CH9141_Demo(void)
                 Error_Handler();
 
             /* Set BLE IC's baudrate to match MCU's UART baudrate */
-            strcpy(paramSet, "115200,8,1,0,100");
             CH9141_SerialSet(ble1, 115200, 8, 1, CH9141_SERIAL_PARITY_NONE, 100);
-            strncpy(bleResponse, CH9141_SerialGet(ble1), ble1->responseLen);
-            if (strcmp(bleResponse, paramSet) != 0)
+            CH9141_SerialGetEx(ble1, &serial);
+            if ((ble1->error != CH9141_ERR_NONE) || (serial.baudRate != 115200) || (serial.timeout != 100))
                 Error_Handler();
         }
     }
@@ -51,14 +53,14 @@ void CH9141_Demo(void)
 
     strcpy(paramSet, "DeviceName");
     CH9141_DeviceNameSet(ble1, paramSet);
-    strncpy(bleResponse, CH9141_DeviceNameGet(ble1), ble1->responseLen);
-    if (strcmp(bleResponse, paramSet) != 0)
+    CH9141_DeviceNameGetEx(ble1, &name);
+    if ((ble1->error != CH9141_ERR_NONE) || (strcmp(name.str, paramSet) != 0))
         Error_Handler();
 
     strcpy(paramSet, "ChipName");
     CH9141_ChipNameSet(ble1, paramSet);
-    strncpy(bleResponse, CH9141_ChipNameGet(ble1), ble1->responseLen);
-    if (strcmp(bleResponse, paramSet) != 0)
+    CH9141_ChipNameGetEx(ble1, &name);
+    if ((ble1->error != CH9141_ERR_NONE) || (strcmp(name.str, paramSet) != 0))
         Error_Handler();
 
     ch9141_SleepMode_t sleepMode = CH9141_SLEEPMODE_LOW_ENERGY;
@@ -91,10 +93,10 @@ void CH9141_Demo(void)
     if (strcmp(bleResponse, paramSet) != 0)
         Error_Handler();
 
-    strcpy(paramSet, "05:DF:39:4C:99:B4");
-    CH9141_MACLocalSet(ble1, paramSet);
-    strncpy(bleResponse, CH9141_MACLocalGet(ble1), ble1->responseLen);
-    if (strcmp(bleResponse, paramSet) != 0)
+    ch9141_MAC_t mac = {.addr = {0x05, 0xDF, 0x39, 0x4C, 0x99, 0xB4}};
+    CH9141_MACLocalSet(ble1, "05:DF:39:4C:99:B4");
+    CH9141_MACLocalGetEx(ble1, &macLocal);
+    if ((ble1->error != CH9141_ERR_NONE) || (memcmp(macLocal.addr, mac.addr, sizeof(mac.addr)) != 0))
         Error_Handler();
 
     vcc = CH9141_VCCGet(ble1);
@@ -125,7 +127,7 @@ void CH9141_Demo(void)
     while (CH9141_StatusGet(ble1) != CH9141_BLESTAT_CONNECTED)
         if (ble1->error != CH9141_ERR_NONE)
             Error_Handler();
-    strncpy(bleResponse, CH9141_MACRemoteGet(ble1), ble1->responseLen);
+    CH9141_MACRemoteGetEx(ble1, &macRemote);
 
     // CH9141_Disconnect(ble1);
 }
\ No newline at end of file
@@ -1,18 +1,80 @@
 #include "ch9141.h"
 #include <stddef.h>
 
-typedef enum { MODE_UNDEFINED, MODE_AT, MODE_TRANSPARENT } mode_t;
-
-static void ModeSwitch(ch9141_t *handle, mode_t mode);
+#define CH9141_READY_TIMEOUT_BOOT 300 // [ms]. Max time for the device to get ready after reset
+#define CH9141_READY_TIMEOUT_WAKEUP 1000 // [ms]. Max time for the device to get ready after power on or sleep mode exit
+#define CH9141_READY_BACKOFF 10 // [ms]. Initial interval between readiness probes, doubled after each one
+#define CH9141_AT_IDLE 500 // [ms]. Serial line idle time required by software AT mode enter
+#define CH9141_RELOAD_HOLD 2000 // [ms]. `Reload` pin low time after boot to restore factory settings
+#define CH9141_BAUD_FACTORY 115200 // Device baudrate after factory restore
+#define CH9141_ASYNC_TIMEOUT 200 // [ms]. Max time to wait for AT command response within asynchronous operation
+#define CH9141_ASYNC_LINK_TIMEOUT 1000 // [ms]. Max time to wait for `LINK OK` message within asynchronous connection
+
+#ifdef CH9141_STATS
+#define STATS_INC(handle, counter) ((handle)->stats.counter++)
+#else
+#define STATS_INC(handle, counter) ((void) 0)
+#endif
+
+typedef enum {
+    ASYNC_STEP_AT_ENTER,
+    ASYNC_STEP_AT_IDLE, // Software AT mode: wait for free UART before `AT...`
+    ASYNC_STEP_AT_RESPONSE,
+    ASYNC_STEP_AT_SETTLE,
+    ASYNC_STEP_CMD,
+    ASYNC_STEP_CMD_RESPONSE,
+    ASYNC_STEP_LINK, // Connect only: wait for `LINK OK`
+    ASYNC_STEP_EXIT,
+    ASYNC_STEP_EXIT_RESPONSE,
+    ASYNC_STEP_EXIT_SETTLE,
+    ASYNC_STEP_DONE
+} asyncStep_t;
+
+static void ModeSwitch(ch9141_t *handle, ch9141_IfcMode_t mode);
 static void CMD_Get(ch9141_t *handle, char const *cmd);
 static void CMD_Set(ch9141_t *handle, char const *cmd);
+static void CMD_Exchange(ch9141_t *handle, char const *cmd);
+static void CMD_GetCached(ch9141_t *handle, char const *cmd);
+static int8_t Cache_Key(char const *cmd);
+static void Cache_Put(ch9141_t *handle, int8_t key, char const *value);
+static void Cache_Store(ch9141_t *handle, char const *cmd);
+static bool Response_Receive(ch9141_t *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
+static ch9141_ErrorStatus_t Ifc_Transmit(ch9141_t *handle, char const *pDataTx, uint16_t size);
+static ch9141_ErrorStatus_t Ifc_Receive(ch9141_t *handle, ch9141_TraceKind_t kind, char *pDataRx, uint16_t size,
+                                        uint16_t *rxLen);
+static void Response_Check(ch9141_t *handle);
+static void Response_Trim(ch9141_t *handle);
+static bool Serial_Parse(char const *pResponse, ch9141_SerialCfg_t *serial);
+static bool MAC_Parse(char const *pResponse, ch9141_MAC_t *mac);
+static bool Name_Parse(char const *pResponse, ch9141_Name_t *name);
 static void Reset(ch9141_t *handle);
+static void Reset_Baud(ch9141_t *handle, uint32_t baudRate);
+static void Reset_Apply(ch9141_t *handle);
 static void Reload(ch9141_t *handle);
+static bool Hello_Wait(ch9141_t *handle);
+static bool Ready_Wait(ch9141_t *handle, uint32_t timeout);
+static bool Baud_Set(ch9141_t *handle, uint32_t baudRate);
+static bool Baud_Detect(ch9141_t *handle, uint32_t timeout);
+static bool Baud_Write(ch9141_t *handle, uint32_t baudRate, char const *serial);
+static bool Baud_Verify(ch9141_t *handle, uint32_t baudRate);
+static ch9141_ErrorStatus_t Async_Start(ch9141_t *handle, ch9141_State_t op, char const *cmd);
+static ch9141_ErrorStatus_t Async_Reject(ch9141_t *handle, ch9141_Error_t error);
+static bool Async_Busy(ch9141_t *handle);
+static bool Async_Receive(ch9141_t *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
+static void Async_Flush(ch9141_t *handle);
+static bool Async_Transmit(ch9141_t *handle, char const *pDataTx, uint32_t now);
+static void Async_Finish(ch9141_t *handle);
 static bool Device_Check(ch9141_t *handle);
 static bool ModePin_Check(ch9141_t *handle);
-
-static bool softwareModeForce = false; // Use `AT.../AT+EXIT` instead of AT mode pin
-static mode_t modeForce = MODE_UNDEFINED;
+#ifdef CH9141_STATS
+static void Stats_Exchange(ch9141_t *handle, ch9141_State_t op, ch9141_Error_t error, uint32_t elapsed);
+#endif
+#ifdef CH9141_TRACE
+static void Trace_Put(ch9141_t *handle, ch9141_TraceKind_t kind, ch9141_ErrorStatus_t status, char const *pData,
+                      uint16_t len);
+static void Trace_Read(ch9141_t const *handle, uint32_t offset, void *pData, uint16_t size);
+static void Trace_Write(ch9141_t *handle, uint32_t offset, void const *pData, uint16_t size);
+#endif
 
 void CH9141_Init(ch9141_t *handle, bool factoryRestore)
 {
@@ -40,7 +102,6 @@ void CH9141_Init(ch9141_t *handle, bool factoryRestore)
     /* Exit from sleep mode */
     if (handle->interface.pinSleep != NULL)
         handle->interface.pinSleep(CH9141_PIN_STATE_SET);
-    handle->interface.delay(1000);
 
     /* Set default pin states */
     if (handle->interface.pinMode != NULL)
@@ -50,6 +111,12 @@ void CH9141_Init(ch9141_t *handle, bool factoryRestore)
     if (handle->interface.pinReload != NULL)
         handle->interface.pinReload(CH9141_PIN_STATE_SET);
 
+    /* Wait for the device to wake up, looking for its baudrate if requested */
+    if ((handle->interface.baudSet != NULL) && (handle->baudCandidates != NULL) && (handle->baudCandidatesNum != 0))
+        Baud_Detect(handle, CH9141_READY_TIMEOUT_WAKEUP);
+    else
+        Ready_Wait(handle, CH9141_READY_TIMEOUT_WAKEUP);
+
     /* Basic device check */
     if (!Device_Check(handle))
         return; // Device not found or not responsive
@@ -66,20 +133,246 @@ void CH9141_Init(ch9141_t *handle, bool factoryRestore)
     handle->state = CH9141_STATE_IDLE;
 }
 
+void CH9141_SessionBegin(ch9141_t *handle)
+{
+    if (handle == NULL)
+        return;
+
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
+        return;
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_SESSION_BEGIN;
+
+    /* Enter AT mode once for the whole session. Cached values may spare it, so the first command enters then */
+    if (!handle->session)
+    {
+        handle->session = true;
+        if (!handle->cacheEn)
+            ModeSwitch(handle, CH9141_IFC_MODE_AT);
+        if (handle->error != CH9141_ERR_NONE)
+        {
+            handle->session = false;
+            return;
+        }
+    }
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_IDLE;
+}
+
+void CH9141_SessionEnd(ch9141_t *handle)
+{
+    if (handle == NULL)
+        return;
+
+    if (!handle->session)
+        return;
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_SESSION_END;
+
+    /* Back to transparent mode regardless of any errors within the session */
+    handle->session = false;
+    if (handle->sessionAT)
+    {
+        handle->sessionAT = false;
+        ModeSwitch(handle, CH9141_IFC_MODE_TRANSPARENT);
+    }
+    if (handle->error != CH9141_ERR_NONE)
+        return;
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_IDLE;
+}
+
+void CH9141_ResetDefer(ch9141_t *handle, ch9141_FuncState_t funcState)
+{
+    if (handle == NULL)
+        return;
+
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
+        return;
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_RESET_DEFER;
+
+    switch (funcState)
+    {
+    case CH9141_FUNC_STATE_DISABLE:
+        handle->resetDefer = false;
+        break;
+
+    case CH9141_FUNC_STATE_ENABLE:
+        handle->resetDefer = true;
+        break;
+
+    default:
+        handle->error = CH9141_ERR_ARGUMENT;
+        return;
+    }
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_IDLE;
+}
+
+void CH9141_Commit(ch9141_t *handle)
+{
+    if (handle == NULL)
+        return;
+
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
+        return;
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_COMMIT;
+
+    /* Reset device once to take effect of all postponed settings */
+    if (handle->resetPending)
+    {
+        Reset(handle);
+        if (handle->error != CH9141_ERR_NONE)
+            return;
+    }
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_IDLE;
+}
+
+void CH9141_Apply(ch9141_t *handle, ch9141_Config_t const *config)
+{
+    ch9141_SerialCfg_t serial = {0};
+    char const *pResponse;
+    ch9141_Error_t error;
+    bool resetDefer;
+    bool session;
+
+    if (handle == NULL)
+        return;
+
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
+        return;
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_APPLY;
+
+    /* Check arguments */
+    if (config == NULL)
+    {
+        handle->error = CH9141_ERR_ARGUMENT;
+        return;
+    }
+
+    /* Read and write all the parameters within the single session and reset device only once */
+    resetDefer = handle->resetDefer;
+    session = handle->session;
+    CH9141_SessionBegin(handle);
+    handle->resetDefer = true;
+
+    /* Any getter failure is kept in the handle, so subsequent setters do nothing */
+    if (config->deviceName != NULL)
+    {
+        pResponse = CH9141_DeviceNameGet(handle);
+        if ((pResponse == NULL) || (strcmp(pResponse, config->deviceName) != 0))
+            CH9141_DeviceNameSet(handle, config->deviceName);
+    }
+
+    if (config->chipName != NULL)
+    {
+        pResponse = CH9141_ChipNameGet(handle);
+        if ((pResponse == NULL) || (strcmp(pResponse, config->chipName) != 0))
+            CH9141_ChipNameSet(handle, config->chipName);
+    }
+
+    if (config->hello != NULL)
+    {
+        pResponse = CH9141_HelloGet(handle);
+        if ((pResponse == NULL) || (strcmp(pResponse, config->hello) != 0))
+            CH9141_HelloSet(handle, config->hello);
+    }
+
+    if (config->password != NULL)
+    {
+        pResponse = CH9141_PasswordGet(handle);
+        if ((pResponse == NULL) || (strcmp(pResponse, config->password) != 0))
+            CH9141_PasswordSet(handle, config->password, config->passwordState);
+    }
+
+    if (config->power != CH9141_POWER_UNDEFINED)
+    {
+        if (CH9141_PowerGet(handle) != config->power)
+            CH9141_PowerSet(handle, config->power);
+    }
+
+    if (config->sleepMode != CH9141_SLEEPMODE_UNDEFINED)
+    {
+        if (CH9141_SleepGet(handle) != config->sleepMode)
+            CH9141_SleepSet(handle, config->sleepMode);
+    }
+
+    if (config->mode != CH9141_MODE_UNDEFINED)
+    {
+        if (CH9141_ModeGet(handle) != config->mode)
+            CH9141_ModeSet(handle, config->mode);
+    }
+
+    if (config->gpioEn <= UINT8_MAX)
+    {
+        if (CH9141_GPIOEnGet(handle) != config->gpioEn)
+            CH9141_GPIOEnSet(handle, config->gpioEn);
+    }
+
+    if (config->gpioInit <= UINT8_MAX)
+    {
+        if (CH9141_GPIOInitGet(handle) != config->gpioInit)
+            CH9141_GPIOInitSet(handle, config->gpioInit);
+    }
+
+    /* Serial interface parameters are the last, because new baudrate takes effect after reset */
+    if (config->serial.baudRate != 0)
+    {
+        CH9141_SerialGetEx(handle, &serial);
+        if ((serial.baudRate != config->serial.baudRate) || (serial.dataBit != config->serial.dataBit) ||
+            (serial.stopBit != config->serial.stopBit) || (serial.parity != config->serial.parity) ||
+            (serial.timeout != config->serial.timeout))
+            CH9141_SerialSet(handle, config->serial.baudRate, config->serial.dataBit, config->serial.stopBit,
+                             config->serial.parity, config->serial.timeout);
+    }
+
+    /* Reset device if any parameter has been written, even if the subsequent one has failed. The first error is kept */
+    error = handle->error;
+    handle->error = CH9141_ERR_NONE;
+    CH9141_Commit(handle);
+    if (error != CH9141_ERR_NONE)
+        handle->error = error;
+    handle->resetDefer = resetDefer;
+    if (!session)
+        CH9141_SessionEnd(handle); // Session opened by the caller is kept
+    if (handle->error != CH9141_ERR_NONE)
+        return;
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_IDLE;
+}
+
 char *CH9141_SerialGet(ch9141_t *handle)
 {
     if (handle == NULL)
         return NULL;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return NULL;
 
     /* Set operational state */
     handle->state = CH9141_STATE_SERIAL_GET;
 
     /* Request the parameter */
-    CMD_Get(handle, "AT+UART?");
+    CMD_GetCached(handle, "AT+UART?");
     if (handle->error != CH9141_ERR_NONE)
         return NULL;
 
@@ -89,6 +382,41 @@ char *CH9141_SerialGet(ch9141_t *handle)
     return handle->rxBuf;
 }
 
+void CH9141_SerialGetEx(ch9141_t *handle, ch9141_SerialCfg_t *serial)
+{
+    if (handle == NULL)
+        return;
+
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
+        return;
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_SERIAL_GET;
+
+    /* Check arguments */
+    if (serial == NULL)
+    {
+        handle->error = CH9141_ERR_ARGUMENT;
+        return;
+    }
+
+    /* Request the parameter */
+    CMD_GetCached(handle, "AT+UART?");
+    if (handle->error != CH9141_ERR_NONE)
+        return;
+
+    /* Fill the parameters right from the response */
+    if (!Serial_Parse(handle->rxBuf, serial))
+    {
+        handle->error = CH9141_ERR_RESPONSE;
+        return;
+    }
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_IDLE;
+}
+
 void CH9141_SerialSet(ch9141_t *handle, uint32_t baudRate, uint8_t dataBit, uint8_t stopBit,
                       ch9141_SerialParity_t parity, uint16_t timeout)
 {
@@ -97,8 +425,8 @@ void CH9141_SerialSet(ch9141_t *handle, uint32_t baudRate, uint8_t dataBit, uint
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -132,9 +460,99 @@ void CH9141_SerialSet(ch9141_t *handle, uint32_t baudRate, uint8_t dataBit, uint
     CMD_Set(handle, cmd);
     if (handle->error != CH9141_ERR_NONE)
         return;
+    Cache_Store(handle, cmd);
 
     /* Reset device to take effect */
-    Reset(handle);
+    Reset_Apply(handle);
+    if (handle->error != CH9141_ERR_NONE)
+        return;
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_IDLE;
+}
+
+void CH9141_BaudNegotiate(ch9141_t *handle, uint32_t maxBaud)
+{
+    static uint32_t const baudRates[] = {1000000, 921600, 460800, 230400, 115200, 57600, 38400, 19200, 9600};
+    char serial[sizeof(handle->rxBuf)] = {0};
+    char *pSerial;
+    uint32_t baudRate;
+    bool session;
+
+    if (handle == NULL)
+        return;
+
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
+        return;
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_BAUD_NEGOTIATE;
+
+    /* Check arguments */
+    if (handle->interface.baudSet == NULL)
+    {
+        handle->error = CH9141_ERR_INTERFACE;
+        return;
+    }
+    if ((maxBaud == 0) || (maxBaud > 1e6))
+    {
+        handle->error = CH9141_ERR_ARGUMENT;
+        return;
+    }
+
+    session = handle->session;
+    CH9141_SessionBegin(handle);
+
+    /* Serial parameters are changed below, the device is asked directly */
+    handle->cache.valid &= ~(1u << Cache_Key("AT+UART?"));
+
+    /* Current baudrate and the rest of serial parameters, which are kept */
+    CMD_Get(handle, "AT+UART?");
+    pSerial = strchr(handle->rxBuf, ',');
+    if ((handle->error == CH9141_ERR_NONE) && (pSerial == NULL))
+        handle->error = CH9141_ERR_RESPONSE;
+    if (handle->error != CH9141_ERR_NONE)
+    {
+        if (!session)
+            CH9141_SessionEnd(handle);
+        return;
+    }
+    baudRate = strtoul(handle->rxBuf, NULL, 10);
+    handle->baudRate = baudRate;
+    strcpy(serial, pSerial);
+
+    for (uint8_t i = 0; (i < sizeof(baudRates) / sizeof(baudRates[0])) && (baudRates[i] > baudRate); i++)
+    {
+        if (baudRates[i] > maxBaud)
+            continue;
+
+        /* Skip baudrates not supported by the host */
+        if (!Baud_Set(handle, baudRates[i]))
+            continue;
+        Baud_Set(handle, baudRate);
+
+        /* Device refuses the baudrate */
+        if (!Baud_Write(handle, baudRates[i], serial))
+            continue;
+        if (Baud_Verify(handle, baudRates[i]))
+        {
+            baudRate = baudRates[i];
+            break;
+        }
+
+        /* Fall back to the previous baudrate: the link may not work at the new one, or the device has not switched */
+        if (!Baud_Write(handle, baudRate, serial))
+            Baud_Set(handle, baudRate);
+        if (!Baud_Verify(handle, baudRate))
+        {
+            handle->error = CH9141_ERR_NO_DEVICE;
+            break;
+        }
+    }
+
+    if (!session)
+        CH9141_SessionEnd(handle); // Session opened by the caller is kept
     if (handle->error != CH9141_ERR_NONE)
         return;
 
@@ -149,8 +567,8 @@ void CH9141_Connect(ch9141_t *handle, char const *mac, char const *password)
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -193,8 +611,8 @@ void CH9141_Disconnect(ch9141_t *handle)
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -214,17 +632,18 @@ char *CH9141_HelloGet(ch9141_t *handle)
     if (handle == NULL)
         return NULL;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return NULL;
 
     /* Set operational state */
     handle->state = CH9141_STATE_HELLO_GET;
 
     /* Request the parameter */
-    CMD_Get(handle, "AT+HELLO?");
+    CMD_GetCached(handle, "AT+HELLO?");
     if (handle->error != CH9141_ERR_NONE)
         return NULL;
+    handle->helloOff = (handle->rxBuf[0] == '\0');
 
     /* Set operational state */
     handle->state = CH9141_STATE_IDLE;
@@ -239,8 +658,8 @@ void CH9141_HelloSet(ch9141_t *handle, char const *helloSet)
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -264,9 +683,11 @@ void CH9141_HelloSet(ch9141_t *handle, char const *helloSet)
     CMD_Set(handle, cmd);
     if (handle->error != CH9141_ERR_NONE)
         return;
+    Cache_Store(handle, cmd);
+    handle->helloOff = (helloSet[0] == '\0');
 
     /* Reset device to take effect */
-    Reset(handle);
+    Reset_Apply(handle);
     if (handle->error != CH9141_ERR_NONE)
         return;
 
@@ -279,15 +700,15 @@ char *CH9141_DeviceNameGet(ch9141_t *handle)
     if (handle == NULL)
         return NULL;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return NULL;
 
     /* Set operational state */
     handle->state = CH9141_STATE_DEVICENAME_GET;
 
     /* Request the parameter */
-    CMD_Get(handle, "AT+PNAME?");
+    CMD_GetCached(handle, "AT+PNAME?");
     if (handle->error != CH9141_ERR_NONE)
         return NULL;
 
@@ -297,6 +718,41 @@ char *CH9141_DeviceNameGet(ch9141_t *handle)
     return handle->rxBuf;
 }
 
+void CH9141_DeviceNameGetEx(ch9141_t *handle, ch9141_Name_t *name)
+{
+    if (handle == NULL)
+        return;
+
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
+        return;
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_DEVICENAME_GET;
+
+    /* Check arguments */
+    if (name == NULL)
+    {
+        handle->error = CH9141_ERR_ARGUMENT;
+        return;
+    }
+
+    /* Request the parameter */
+    CMD_GetCached(handle, "AT+PNAME?");
+    if (handle->error != CH9141_ERR_NONE)
+        return;
+
+    /* Fill the name right from the response */
+    if (!Name_Parse(handle->rxBuf, name))
+    {
+        handle->error = CH9141_ERR_RESPONSE;
+        return;
+    }
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_IDLE;
+}
+
 void CH9141_DeviceNameSet(ch9141_t *handle, char const *nameSet)
 {
     char cmd[30] = {0};
@@ -304,8 +760,8 @@ void CH9141_DeviceNameSet(ch9141_t *handle, char const *nameSet)
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -329,9 +785,10 @@ void CH9141_DeviceNameSet(ch9141_t *handle, char const *nameSet)
     CMD_Set(handle, cmd);
     if (handle->error != CH9141_ERR_NONE)
         return;
+    Cache_Store(handle, cmd);
 
     /* Reset device to take effect */
-    Reset(handle);
+    Reset_Apply(handle);
     if (handle->error != CH9141_ERR_NONE)
         return;
 
@@ -344,15 +801,15 @@ char *CH9141_ChipNameGet(ch9141_t *handle)
     if (handle == NULL)
         return NULL;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return NULL;
 
     /* Set operational state */
     handle->state = CH9141_STATE_CHIPNAME_GET;
 
     /* Request the parameter */
-    CMD_Get(handle, "AT+NAME?");
+    CMD_GetCached(handle, "AT+NAME?");
     if (handle->error != CH9141_ERR_NONE)
         return NULL;
 
@@ -362,6 +819,41 @@ char *CH9141_ChipNameGet(ch9141_t *handle)
     return handle->rxBuf;
 }
 
+void CH9141_ChipNameGetEx(ch9141_t *handle, ch9141_Name_t *name)
+{
+    if (handle == NULL)
+        return;
+
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
+        return;
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_CHIPNAME_GET;
+
+    /* Check arguments */
+    if (name == NULL)
+    {
+        handle->error = CH9141_ERR_ARGUMENT;
+        return;
+    }
+
+    /* Request the parameter */
+    CMD_GetCached(handle, "AT+NAME?");
+    if (handle->error != CH9141_ERR_NONE)
+        return;
+
+    /* Fill the name right from the response */
+    if (!Name_Parse(handle->rxBuf, name))
+    {
+        handle->error = CH9141_ERR_RESPONSE;
+        return;
+    }
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_IDLE;
+}
+
 void CH9141_ChipNameSet(ch9141_t *handle, char const *nameSet)
 {
     char cmd[30] = {0};
@@ -369,8 +861,8 @@ void CH9141_ChipNameSet(ch9141_t *handle, char const *nameSet)
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -394,9 +886,10 @@ void CH9141_ChipNameSet(ch9141_t *handle, char const *nameSet)
     CMD_Set(handle, cmd);
     if (handle->error != CH9141_ERR_NONE)
         return;
+    Cache_Store(handle, cmd);
 
     /* Reset device to take effect */
-    Reset(handle);
+    Reset_Apply(handle);
     if (handle->error != CH9141_ERR_NONE)
         return;
 
@@ -409,8 +902,8 @@ void CH9141_SleepSwitch(ch9141_t *handle, ch9141_FuncState_t funcState)
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -451,15 +944,15 @@ ch9141_SleepMode_t CH9141_SleepGet(ch9141_t *handle)
     if (handle == NULL)
         return CH9141_SLEEPMODE_UNDEFINED;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return CH9141_SLEEPMODE_UNDEFINED;
 
     /* Set operational state */
     handle->state = CH9141_STATE_SLEEP_GET;
 
     /* Request the parameter */
-    CMD_Get(handle, "AT+SLEEP?");
+    CMD_GetCached(handle, "AT+SLEEP?");
     if (handle->error != CH9141_ERR_NONE)
         return CH9141_SLEEPMODE_UNDEFINED;
 
@@ -490,8 +983,8 @@ void CH9141_SleepSet(ch9141_t *handle, ch9141_SleepMode_t sleepMode)
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -507,9 +1000,10 @@ void CH9141_SleepSet(ch9141_t *handle, ch9141_SleepMode_t sleepMode)
     CMD_Set(handle, cmd);
     if (handle->error != CH9141_ERR_NONE)
         return;
+    Cache_Store(handle, cmd);
 
     /* Reset device to take effect */
-    Reset(handle);
+    Reset_Apply(handle);
     if (handle->error != CH9141_ERR_NONE)
         return;
 
@@ -524,15 +1018,15 @@ ch9141_Power_t CH9141_PowerGet(ch9141_t *handle)
     if (handle == NULL)
         return CH9141_POWER_UNDEFINED;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return CH9141_POWER_UNDEFINED;
 
     /* Set operational state */
     handle->state = CH9141_STATE_POWER_GET;
 
     /* Request the parameter */
-    CMD_Get(handle, "AT+TPL?");
+    CMD_GetCached(handle, "AT+TPL?");
     if (handle->error != CH9141_ERR_NONE)
         return CH9141_POWER_UNDEFINED;
 
@@ -559,8 +1053,8 @@ void CH9141_PowerSet(ch9141_t *handle, ch9141_Power_t power)
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -576,9 +1070,10 @@ void CH9141_PowerSet(ch9141_t *handle, ch9141_Power_t power)
     CMD_Set(handle, cmd);
     if (handle->error != CH9141_ERR_NONE)
         return;
+    Cache_Store(handle, cmd);
 
     /* Reset device to take effect */
-    Reset(handle);
+    Reset_Apply(handle);
     if (handle->error != CH9141_ERR_NONE)
         return;
 
@@ -591,15 +1086,15 @@ ch9141_Mode_t CH9141_ModeGet(ch9141_t *handle)
     if (handle == NULL)
         return CH9141_MODE_UNDEFINED;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return CH9141_MODE_UNDEFINED;
 
     /* Set operational state */
     handle->state = CH9141_STATE_MODE_GET;
 
     /* Request the parameter */
-    CMD_Get(handle, "AT+BLEMODE?");
+    CMD_GetCached(handle, "AT+BLEMODE?");
     if (handle->error != CH9141_ERR_NONE)
         return CH9141_MODE_UNDEFINED;
 
@@ -616,8 +1111,8 @@ void CH9141_ModeSet(ch9141_t *handle, ch9141_Mode_t mode)
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -633,9 +1128,10 @@ void CH9141_ModeSet(ch9141_t *handle, ch9141_Mode_t mode)
     CMD_Set(handle, cmd);
     if (handle->error != CH9141_ERR_NONE)
         return;
+    Cache_Store(handle, cmd);
 
     /* Reset device to take effect */
-    Reset(handle);
+    Reset_Apply(handle);
     if (handle->error != CH9141_ERR_NONE)
         return;
 
@@ -648,15 +1144,15 @@ char *CH9141_PasswordGet(ch9141_t *handle)
     if (handle == NULL)
         return NULL;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return NULL;
 
     /* Set operational state */
     handle->state = CH9141_STATE_PASSWORD_GET;
 
     /* Request the parameter */
-    CMD_Get(handle, "AT+PASS?");
+    CMD_GetCached(handle, "AT+PASS?");
     if (handle->error != CH9141_ERR_NONE)
         return NULL;
 
@@ -673,8 +1169,8 @@ void CH9141_PasswordSet(ch9141_t *handle, char const *passwordSet, ch9141_FuncSt
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -707,6 +1203,7 @@ void CH9141_PasswordSet(ch9141_t *handle, char const *passwordSet, ch9141_FuncSt
     CMD_Set(handle, cmd);
     if (handle->error != CH9141_ERR_NONE)
         return;
+    Cache_Store(handle, cmd);
 
     /* Set password state ON/OFF */
     switch (funcState)
@@ -727,7 +1224,7 @@ void CH9141_PasswordSet(ch9141_t *handle, char const *passwordSet, ch9141_FuncSt
         return;
 
     /* Reset device to take effect */
-    Reset(handle);
+    Reset_Apply(handle);
     if (handle->error != CH9141_ERR_NONE)
         return;
 
@@ -740,8 +1237,8 @@ ch9141_BLEStatus_t CH9141_StatusGet(ch9141_t *handle)
     if (handle == NULL)
         return CH9141_BLESTAT_UNDEFINED;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return CH9141_BLESTAT_UNDEFINED;
 
     /* Set operational state */
@@ -763,15 +1260,15 @@ char *CH9141_MACLocalGet(ch9141_t *handle)
     if (handle == NULL)
         return NULL;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return NULL;
 
     /* Set operational state */
     handle->state = CH9141_STATE_MAC_LOCAL_GET;
 
     /* Request the parameter */
-    CMD_Get(handle, "AT+MAC?");
+    CMD_GetCached(handle, "AT+MAC?");
     if (handle->error != CH9141_ERR_NONE)
         return NULL;
 
@@ -781,6 +1278,41 @@ char *CH9141_MACLocalGet(ch9141_t *handle)
     return handle->rxBuf;
 }
 
+void CH9141_MACLocalGetEx(ch9141_t *handle, ch9141_MAC_t *mac)
+{
+    if (handle == NULL)
+        return;
+
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
+        return;
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_MAC_LOCAL_GET;
+
+    /* Check arguments */
+    if (mac == NULL)
+    {
+        handle->error = CH9141_ERR_ARGUMENT;
+        return;
+    }
+
+    /* Request the parameter */
+    CMD_GetCached(handle, "AT+MAC?");
+    if (handle->error != CH9141_ERR_NONE)
+        return;
+
+    /* Fill the address right from the response */
+    if (!MAC_Parse(handle->rxBuf, mac))
+    {
+        handle->error = CH9141_ERR_RESPONSE;
+        return;
+    }
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_IDLE;
+}
+
 void CH9141_MACLocalSet(ch9141_t *handle, char const *mac)
 {
     char cmd[30] = {0};
@@ -788,8 +1320,8 @@ void CH9141_MACLocalSet(ch9141_t *handle, char const *mac)
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -813,9 +1345,10 @@ void CH9141_MACLocalSet(ch9141_t *handle, char const *mac)
     CMD_Set(handle, cmd);
     if (handle->error != CH9141_ERR_NONE)
         return;
+    Cache_Store(handle, cmd);
 
     /* Reset device to take effect */
-    Reset(handle);
+    Reset_Apply(handle);
     if (handle->error != CH9141_ERR_NONE)
         return;
 
@@ -828,8 +1361,8 @@ char *CH9141_MACRemoteGet(ch9141_t *handle)
     if (handle == NULL)
         return NULL;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return NULL;
 
     /* Set operational state */
@@ -846,13 +1379,48 @@ char *CH9141_MACRemoteGet(ch9141_t *handle)
     return handle->rxBuf;
 }
 
+void CH9141_MACRemoteGetEx(ch9141_t *handle, ch9141_MAC_t *mac)
+{
+    if (handle == NULL)
+        return;
+
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
+        return;
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_MAC_REMOTE_GET;
+
+    /* Check arguments */
+    if (mac == NULL)
+    {
+        handle->error = CH9141_ERR_ARGUMENT;
+        return;
+    }
+
+    /* Request the parameter */
+    CMD_Get(handle, "AT+CCADD?");
+    if (handle->error != CH9141_ERR_NONE)
+        return;
+
+    /* Fill the address right from the response */
+    if (!MAC_Parse(handle->rxBuf, mac))
+    {
+        handle->error = CH9141_ERR_RESPONSE;
+        return;
+    }
+
+    /* Set operational state */
+    handle->state = CH9141_STATE_IDLE;
+}
+
 uint16_t CH9141_VCCGet(ch9141_t *handle)
 {
     if (handle == NULL)
         return UINT16_MAX;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return UINT16_MAX;
 
     /* Set operational state */
@@ -874,8 +1442,8 @@ uint16_t CH9141_ADCGet(ch9141_t *handle)
     if (handle == NULL)
         return UINT16_MAX;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return UINT16_MAX;
 
     /* Set operational state */
@@ -900,8 +1468,8 @@ ch9141_PinState_t CH9141_GPIOGet(ch9141_t *handle, uint8_t pin)
     if (handle == NULL)
         return CH9141_PIN_STATE_UNDEFINED;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return CH9141_PIN_STATE_UNDEFINED;
 
     /* Set operational state */
@@ -951,8 +1519,8 @@ void CH9141_GPIOSet(ch9141_t *handle, uint8_t pin, ch9141_PinState_t pinState)
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -995,15 +1563,15 @@ uint16_t CH9141_GPIOInitGet(ch9141_t *handle)
     if (handle == NULL)
         return UINT16_MAX;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return UINT16_MAX;
 
     /* Set operational state */
     handle->state = CH9141_STATE_GPIO_INIT_GET;
 
     /* Request the parameter */
-    CMD_Get(handle, "AT+INITIO?");
+    CMD_GetCached(handle, "AT+INITIO?");
     if (handle->error != CH9141_ERR_NONE)
         return UINT16_MAX;
 
@@ -1020,8 +1588,8 @@ void CH9141_GPIOInitSet(ch9141_t *handle, uint8_t configIO)
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -1034,6 +1602,7 @@ void CH9141_GPIOInitSet(ch9141_t *handle, uint8_t configIO)
     CMD_Set(handle, cmd);
     if (handle->error != CH9141_ERR_NONE)
         return;
+    Cache_Store(handle, cmd);
 
     /* Set operational state */
     handle->state = CH9141_STATE_IDLE;
@@ -1044,15 +1613,15 @@ uint16_t CH9141_GPIOEnGet(ch9141_t *handle)
     if (handle == NULL)
         return UINT16_MAX;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return UINT16_MAX;
 
     /* Set operational state */
     handle->state = CH9141_STATE_GPIO_EN_GET;
 
     /* Request the parameter */
-    CMD_Get(handle, "AT+IOEN?");
+    CMD_GetCached(handle, "AT+IOEN?");
     if (handle->error != CH9141_ERR_NONE)
         return UINT16_MAX;
 
@@ -1069,8 +1638,8 @@ void CH9141_GPIOEnSet(ch9141_t *handle, uint8_t configIO)
     if (handle == NULL)
         return;
 
-    /* Check any existing errors */
-    if (handle->error != CH9141_ERR_NONE)
+    /* Check any existing errors and asynchronous operation in progress */
+    if ((handle->error != CH9141_ERR_NONE) || Async_Busy(handle))
         return;
 
     /* Set operational state */
@@ -1083,90 +1652,474 @@ void CH9141_GPIOEnSet(ch9141_t *handle, uint8_t configIO)
     CMD_Set(handle, cmd);
     if (handle->error != CH9141_ERR_NONE)
         return;
+    Cache_Store(handle, cmd);
 
     /* Set operational state */
     handle->state = CH9141_STATE_IDLE;
 }
 
-/**
- * @section Private func definitions
- */
+void CH9141_CacheInvalidate(ch9141_t *handle)
+{
+    if (handle == NULL)
+        return;
 
-/**
- * @brief Internal function used to switch between AT and transparent modes
- * @param handle pointer to the device handle
- * @param mode mode to switch to
- */
-static void ModeSwitch(ch9141_t *handle, mode_t mode)
+    handle->cache.valid = 0;
+}
+
+#ifdef CH9141_STATS
+void CH9141_StatsGet(ch9141_t const *handle, ch9141_Stats_t *stats)
 {
-    char const *successResponseTemplate = "OK\r\n";
-    char response[10] = {0};
-    uint16_t responseLen = 0;
+    if ((handle == NULL) || (stats == NULL))
+        return;
 
+    *stats = handle->stats;
+}
+
+void CH9141_StatsReset(ch9141_t *handle)
+{
     if (handle == NULL)
         return;
 
-    if (modeForce != MODE_UNDEFINED)
-        mode = modeForce;
-    switch (mode)
+    memset(&handle->stats, 0, sizeof(handle->stats));
+}
+#endif
+
+#ifdef CH9141_TRACE
+void CH9141_TraceDump(ch9141_t const *handle, ch9141_TracePrint_fp print)
+{
+    static char const *const kinds[] = {"TX", "RX", "RXR", "RXP"};
+    ch9141_TraceRecord_t record;
+    uint8_t payload[CH9141_TRACE_PAYLOAD_MAX];
+    char line[32 + 2 * CH9141_TRACE_PAYLOAD_MAX];
+    uint32_t offset;
+    int len;
+
+    if ((handle == NULL) || (print == NULL))
+        return;
+
+    for (uint32_t done = 0; done < handle->trace.used; done += sizeof(record) + record.len)
+    {
+        offset = (handle->trace.head + done) % sizeof(handle->trace.data);
+        Trace_Read(handle, offset, &record, sizeof(record));
+        Trace_Read(handle, (offset + sizeof(record)) % sizeof(handle->trace.data), payload, record.len);
+
+        /* Payload as hex string, `-` if empty */
+        len = snprintf(line, sizeof(line), "%lu %s %u %u %s", (unsigned long) record.time,
+                       kinds[record.kind % (sizeof(kinds) / sizeof(kinds[0]))], record.ok, record.state,
+                       (record.len == 0) ? "-" : "");
+        for (uint16_t i = 0; i < record.len; i++)
+            len += snprintf(&line[len], sizeof(line) - len, "%02X", payload[i]);
+        snprintf(&line[len], sizeof(line) - len, "\n");
+        print(line);
+    }
+}
+
+void CH9141_TraceClear(ch9141_t *handle)
+{
+    if (handle == NULL)
+        return;
+
+    handle->trace.head = 0;
+    handle->trace.used = 0;
+    handle->trace.dropped = 0;
+}
+#endif
+
+bool CH9141_ResponseIsComplete(char const *pData, uint16_t len)
+{
+    uint16_t digits = len - 2;
+
+    if ((pData == NULL) || (len < strlen("OK\r\n")))
+        return false;
+
+    /* Any response ends with line break */
+    if ((pData[len - 2] != '\r') || (pData[len - 1] != '\n'))
+        return false;
+
+    /* `OK\r\n` or `LINK OK\r\n` */
+    if ((pData[len - 4] == 'O') && (pData[len - 3] == 'K'))
+        return true;
+
+    /* `ERR:n\r\n` */
+    while ((digits != 0) && isdigit((unsigned char) pData[digits - 1]))
+        digits--;
+
+    return (digits != len - 2) && (digits >= strlen("ERR:")) && (strncmp(&pData[digits - 4], "ERR:", 4) == 0);
+}
+
+bool CH9141_Process(ch9141_t *handle, uint32_t now)
+{
+    ch9141_Error_t error;
+    bool expired;
+
+    if (handle == NULL)
+        return false;
+
+    if (!handle->async.active)
+        return false;
+
+    expired = (int32_t) (now - handle->async.deadline) >= 0;
+
+    switch (handle->async.step)
     {
-    case MODE_AT:
+    case ASYNC_STEP_AT_ENTER:
+#ifdef CH9141_STATS
+        handle->async.start = now;
+#endif
         handle->errorAT = CH9141_AT_ERR_NONE;
-        if ((handle->interface.pinMode != NULL) && (!softwareModeForce))
+        if ((handle->interface.pinMode != NULL) && (!handle->softwareModeForce))
+        {
             /* Hardware AT mode enter */
             handle->interface.pinMode(CH9141_PIN_STATE_RESET);
+            STATS_INC(handle, modeSwitches);
+            handle->async.deadline = now + 10;
+            handle->async.step = ASYNC_STEP_AT_SETTLE;
+        }
         else
         {
-            /* Software AT mode enter */
-            /* Send command */
-            handle->interface.delay(500); // Enter AT configuration cmd is sent when UART is free for 500mS
-            snprintf(handle->txBuf, sizeof(handle->txBuf), "AT...\r\n");
-            if (handle->interface.transmit(handle->interface.handle, handle->txBuf, strlen(handle->txBuf)) !=
-                CH9141_ERROR_STATUS_SUCCESS)
-            {
-                handle->error = CH9141_ERR_SERIAL_TX;
-                return;
-            }
+            /* Enter AT configuration cmd is sent when UART is free for 500mS */
+            handle->async.deadline = now + CH9141_AT_IDLE;
+            handle->async.step = ASYNC_STEP_AT_IDLE;
+        }
+        break;
 
-            /* Get response */
-            /* Use separated buffer, because driver rx buffer is used outside to keep the original cmd response */
-            if (handle->interface.receive(handle->interface.handle, response, sizeof(response), &responseLen) !=
-                CH9141_ERROR_STATUS_SUCCESS)
+    case ASYNC_STEP_AT_IDLE:
+        if (!expired)
+            break;
+        if (!Async_Transmit(handle, "AT...\r\n", now))
+        {
+            handle->async.error = CH9141_ERR_SERIAL_TX;
+            handle->async.step = ASYNC_STEP_DONE; // Nothing is sent, mode is unchanged
+            break;
+        }
+        STATS_INC(handle, modeSwitches);
+        handle->async.step = ASYNC_STEP_AT_RESPONSE;
+        break;
+
+    case ASYNC_STEP_AT_RESPONSE:
+        if (!Async_Receive(handle, handle->async.response, sizeof(handle->async.response), &handle->async.responseLen))
+        {
+            if (expired)
             {
-                handle->error = CH9141_ERR_SERIAL_RX;
-                return;
+                /* Device may have entered AT mode regardless */
+                handle->async.error = CH9141_ERR_SERIAL_RX;
+                handle->async.step = ASYNC_STEP_EXIT;
             }
+            break;
+        }
+        if (strcmp(handle->async.response, "OK\r\n") != 0)
+        {
+            handle->async.error = CH9141_ERR_RESPONSE;
+            handle->async.step = ASYNC_STEP_EXIT;
+            break;
+        }
+        handle->async.deadline = now + 10;
+        handle->async.step = ASYNC_STEP_AT_SETTLE;
+        break;
 
-            /* Check response */
-            if (strncmp(response, successResponseTemplate, strlen(successResponseTemplate)) != 0)
+    case ASYNC_STEP_AT_SETTLE:
+        if (expired)
+            handle->async.step = ASYNC_STEP_CMD;
+        break;
+
+    case ASYNC_STEP_CMD:
+        memset(handle->rxBuf, '\0', sizeof(handle->rxBuf));
+        handle->rxLen = 0;
+        if (!Async_Transmit(handle, handle->txBuf, now))
+        {
+            handle->async.error = CH9141_ERR_SERIAL_TX;
+            handle->async.step = ASYNC_STEP_EXIT;
+            break;
+        }
+        handle->async.step = ASYNC_STEP_CMD_RESPONSE;
+        break;
+
+    case ASYNC_STEP_CMD_RESPONSE:
+        if (!Async_Receive(handle, handle->rxBuf, sizeof(handle->rxBuf), &handle->rxLen) && !expired)
+            break;
+        if (handle->rxLen == 0)
+        {
+            /* Nothing received in time */
+            handle->async.error = CH9141_ERR_SERIAL_RX;
+            handle->async.step = ASYNC_STEP_EXIT;
+            break;
+        }
+
+        /* Postpone any response error until the device is back in transparent mode. Handle error may keep the refusal
+         * of a synchronous request made meanwhile */
+        error = handle->error;
+        handle->error = CH9141_ERR_NONE;
+        Response_Check(handle);
+        handle->async.error = handle->error;
+        handle->error = error;
+        if ((handle->async.error == CH9141_ERR_NONE) && (handle->async.op == CH9141_STATE_CONNECT))
+        {
+            handle->async.responseLen = 0;
+            handle->async.deadline = now + CH9141_ASYNC_LINK_TIMEOUT;
+            handle->async.step = ASYNC_STEP_LINK;
+        }
+        else
+            handle->async.step = ASYNC_STEP_EXIT;
+        break;
+
+    case ASYNC_STEP_LINK:
+        if (!Async_Receive(handle, handle->async.response, sizeof(handle->async.response), &handle->async.responseLen))
+        {
+            if (expired)
             {
-                /* Unexpected response message */
-                handle->error = CH9141_ERR_RESPONSE;
-                return;
+                handle->async.error = CH9141_ERR_SERIAL_RX;
+                handle->async.step = ASYNC_STEP_EXIT;
             }
+            break;
         }
+        if (strcmp(handle->async.response, "LINK OK\r\n") != 0)
+            handle->async.error = CH9141_ERR_RESPONSE;
+        handle->async.step = ASYNC_STEP_EXIT;
         break;
 
-    case MODE_TRANSPARENT:
-        if ((handle->interface.pinMode != NULL) && (!softwareModeForce))
+    case ASYNC_STEP_EXIT:
+        if ((handle->interface.pinMode != NULL) && (!handle->softwareModeForce))
+        {
             /* Hardware transparent mode enter */
             handle->interface.pinMode(CH9141_PIN_STATE_SET);
+            STATS_INC(handle, modeSwitches);
+            handle->async.deadline = now + 10;
+            handle->async.step = ASYNC_STEP_EXIT_SETTLE;
+        }
+        else if (!Async_Transmit(handle, "AT+EXIT\r\n", now))
+        {
+            if (handle->async.error == CH9141_ERR_NONE)
+                handle->async.error = CH9141_ERR_SERIAL_TX;
+            handle->async.step = ASYNC_STEP_DONE;
+        }
         else
         {
-            /* Software transparent mode enter */
-            /* Send command */
-            snprintf(handle->txBuf, sizeof(handle->txBuf), "AT+EXIT\r\n");
-            if (handle->interface.transmit(handle->interface.handle, handle->txBuf, strlen(handle->txBuf)) !=
-                CH9141_ERROR_STATUS_SUCCESS)
-            {
-                handle->error = CH9141_ERR_SERIAL_TX;
-                return;
-            }
+            STATS_INC(handle, modeSwitches);
+            handle->async.step = ASYNC_STEP_EXIT_RESPONSE;
+        }
+        break;
 
-            /* Get response */
-            /* Use separated buffer, because driver rx buffer is used outside to keep the original cmd response */
-            if (handle->interface.receive(handle->interface.handle, response, sizeof(response), &responseLen) !=
-                CH9141_ERROR_STATUS_SUCCESS)
+    case ASYNC_STEP_EXIT_RESPONSE:
+        if (!Async_Receive(handle, handle->async.response, sizeof(handle->async.response), &handle->async.responseLen))
+        {
+            if (expired)
+            {
+                if (handle->async.error == CH9141_ERR_NONE)
+                    handle->async.error = CH9141_ERR_SERIAL_RX;
+                handle->async.step = ASYNC_STEP_DONE;
+            }
+            break;
+        }
+        if (strcmp(handle->async.response, "OK\r\n") != 0)
+        {
+            if (handle->async.error == CH9141_ERR_NONE)
+                handle->async.error = CH9141_ERR_RESPONSE;
+            handle->async.step = ASYNC_STEP_DONE;
+            break;
+        }
+        handle->async.deadline = now + 10;
+        handle->async.step = ASYNC_STEP_EXIT_SETTLE;
+        break;
+
+    case ASYNC_STEP_EXIT_SETTLE:
+        if (expired)
+            handle->async.step = ASYNC_STEP_DONE;
+        break;
+
+    default:
+        break;
+    }
+
+    /* Errors are postponed to the completion, so the device is always switched back to transparent mode first */
+    if (handle->async.step == ASYNC_STEP_DONE)
+    {
+#ifdef CH9141_STATS
+        Stats_Exchange(handle, handle->async.op, handle->async.error, now - handle->async.start);
+#endif
+        Async_Finish(handle);
+    }
+
+    return handle->async.active;
+}
+
+ch9141_ErrorStatus_t CH9141_StatusGetAsync(ch9141_t *handle)
+{
+    return Async_Start(handle, CH9141_STATE_STATUS_GET, "AT+BLESTA?");
+}
+
+ch9141_ErrorStatus_t CH9141_MACRemoteGetAsync(ch9141_t *handle)
+{
+    return Async_Start(handle, CH9141_STATE_MAC_REMOTE_GET, "AT+CCADD?");
+}
+
+ch9141_ErrorStatus_t CH9141_VCCGetAsync(ch9141_t *handle)
+{
+    return Async_Start(handle, CH9141_STATE_VCC_GET, "AT+BAT?");
+}
+
+ch9141_ErrorStatus_t CH9141_ADCGetAsync(ch9141_t *handle)
+{
+    return Async_Start(handle, CH9141_STATE_ADC_GET, "AT+ADC?");
+}
+
+ch9141_ErrorStatus_t CH9141_GPIOGetAsync(ch9141_t *handle, uint8_t pin)
+{
+    char cmd[20] = {0};
+
+    if (handle == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Check pin number */
+    if ((pin == 0) || (pin == 2) || (pin > 7))
+        return Async_Reject(handle, CH9141_ERR_ARGUMENT);
+
+    /* Prepare the command */
+    snprintf(cmd, sizeof(cmd), "AT+GPIO%i?", pin);
+
+    return Async_Start(handle, CH9141_STATE_GPIO_GET, cmd);
+}
+
+ch9141_ErrorStatus_t CH9141_GPIOSetAsync(ch9141_t *handle, uint8_t pin, ch9141_PinState_t pinState)
+{
+    char cmd[20] = {0};
+
+    if (handle == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Check pin number */
+    if ((pin == 1) || (pin == 3) || (pin > 7))
+        return Async_Reject(handle, CH9141_ERR_ARGUMENT);
+
+    /* Prepare the command */
+    switch (pinState)
+    {
+    case CH9141_PIN_STATE_RESET:
+        snprintf(cmd, sizeof(cmd), "AT+GPIO%i=0", pin);
+        break;
+
+    case CH9141_PIN_STATE_SET:
+        snprintf(cmd, sizeof(cmd), "AT+GPIO%i=1", pin);
+        break;
+
+    default:
+        return Async_Reject(handle, CH9141_ERR_ARGUMENT);
+    }
+
+    return Async_Start(handle, CH9141_STATE_GPIO_SET, cmd);
+}
+
+ch9141_ErrorStatus_t CH9141_ConnectAsync(ch9141_t *handle, char const *mac, char const *password)
+{
+    char cmd[40] = {0};
+
+    if (handle == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Check arguments */
+    if ((mac == NULL) || (strlen(mac) != 17))
+        return Async_Reject(handle, CH9141_ERR_ARGUMENT);
+    if ((password != NULL) && (strlen(password) != 6))
+        return Async_Reject(handle, CH9141_ERR_ARGUMENT);
+
+    /* Prepare the command */
+    if (password != NULL)
+        snprintf(cmd, sizeof(cmd), "AT+CONN=%s,%s", mac, password);
+    else
+        snprintf(cmd, sizeof(cmd), "AT+CONN=%s", mac);
+
+    return Async_Start(handle, CH9141_STATE_CONNECT, cmd);
+}
+
+ch9141_ErrorStatus_t CH9141_DisconnectAsync(ch9141_t *handle)
+{
+    return Async_Start(handle, CH9141_STATE_DISCONNECT, "AT+DISCONN");
+}
+
+/**
+ * @section Private func definitions
+ */
+
+/**
+ * @brief Internal function used to switch between AT and transparent modes
+ * @param handle pointer to the device handle
+ * @param mode mode to switch to
+ */
+static void ModeSwitch(ch9141_t *handle, ch9141_IfcMode_t mode)
+{
+    char const *successResponseTemplate = "OK\r\n";
+    char response[10] = {0};
+    uint16_t responseLen = 0;
+
+    if (handle == NULL)
+        return;
+
+    if (handle->modeForce != CH9141_IFC_MODE_UNDEFINED)
+        mode = handle->modeForce;
+    else if (handle->session)
+    {
+        /* Keep AT mode until the session end */
+        if ((mode == CH9141_IFC_MODE_TRANSPARENT) || handle->sessionAT)
+            return;
+    }
+
+    switch (mode)
+    {
+    case CH9141_IFC_MODE_AT:
+        STATS_INC(handle, modeSwitches);
+        handle->errorAT = CH9141_AT_ERR_NONE;
+        if ((handle->interface.pinMode != NULL) && (!handle->softwareModeForce))
+            /* Hardware AT mode enter */
+            handle->interface.pinMode(CH9141_PIN_STATE_RESET);
+        else
+        {
+            /* Software AT mode enter */
+            /* Send command */
+            handle->interface.delay(CH9141_AT_IDLE); // Enter AT configuration cmd is sent when UART is free for 500mS
+            snprintf(handle->txBuf, sizeof(handle->txBuf), "AT...\r\n");
+            if (Ifc_Transmit(handle, handle->txBuf, strlen(handle->txBuf)) != CH9141_ERROR_STATUS_SUCCESS)
+            {
+                handle->error = CH9141_ERR_SERIAL_TX;
+                return;
+            }
+
+            /* Get response */
+            /* Use separated buffer, because driver rx buffer is used outside to keep the original cmd response */
+            if (!Response_Receive(handle, response, sizeof(response), &responseLen))
+            {
+                handle->error = CH9141_ERR_SERIAL_RX;
+                return;
+            }
+
+            /* Check response */
+            if (strncmp(response, successResponseTemplate, strlen(successResponseTemplate)) != 0)
+            {
+                /* Unexpected response message */
+                handle->error = CH9141_ERR_RESPONSE;
+                return;
+            }
+        }
+        handle->sessionAT = handle->session;
+        break;
+
+    case CH9141_IFC_MODE_TRANSPARENT:
+        STATS_INC(handle, modeSwitches);
+        if ((handle->interface.pinMode != NULL) && (!handle->softwareModeForce))
+            /* Hardware transparent mode enter */
+            handle->interface.pinMode(CH9141_PIN_STATE_SET);
+        else
+        {
+            /* Software transparent mode enter */
+            /* Send command */
+            snprintf(handle->txBuf, sizeof(handle->txBuf), "AT+EXIT\r\n");
+            if (Ifc_Transmit(handle, handle->txBuf, strlen(handle->txBuf)) != CH9141_ERROR_STATUS_SUCCESS)
+            {
+                handle->error = CH9141_ERR_SERIAL_TX;
+                return;
+            }
+
+            /* Get response */
+            /* Use separated buffer, because driver rx buffer is used outside to keep the original cmd response */
+            if (!Response_Receive(handle, response, sizeof(response), &responseLen))
             {
                 handle->error = CH9141_ERR_SERIAL_RX;
                 return;
@@ -1211,15 +2164,7 @@ static void CMD_Get(ch9141_t *handle, char const *cmd)
         return;
 
     /* Retrieve response from the whole message */
-    if (strtok(handle->rxBuf, "\r") == NULL)
-    {
-        /* Unexpected response message - `\r` token not found */
-        handle->error = CH9141_ERR_RESPONSE;
-        return;
-    }
-
-    /* Update response length field */
-    handle->responseLen = strlen(handle->rxBuf) + 1;
+    Response_Trim(handle);
 }
 
 /**
@@ -1228,11 +2173,30 @@ static void CMD_Get(ch9141_t *handle, char const *cmd)
  * @param cmd AT command to set the parameter. Should be null-terminated string
  */
 static void CMD_Set(ch9141_t *handle, char const *cmd)
+{
+#ifdef CH9141_STATS
+    uint32_t start;
+
+    if (handle == NULL)
+        return;
+
+    start = (handle->interface.tick != NULL) ? handle->interface.tick() : 0;
+    CMD_Exchange(handle, cmd);
+    Stats_Exchange(handle, handle->state, handle->error,
+                   (handle->interface.tick != NULL) ? handle->interface.tick() - start : UINT32_MAX);
+#else
+    CMD_Exchange(handle, cmd);
+#endif
+}
+
+/**
+ * @brief Internal function used to exchange AT command with the device
+ * @param handle pointer to the device handle
+ * @param cmd AT command. Should be null-terminated string
+ */
+static void CMD_Exchange(ch9141_t *handle, char const *cmd)
 {
     char const *connectSuccessResponse = "LINK OK\r\n";
-    char const *successResponseTemplate = "OK\r\n";
-    char const *errorResponseTemplate = "\r\nERR:";
-    char *pResponse = handle->rxBuf;
     char response[10] = {0};
     uint16_t responseLen = 0;
     uint8_t connectAttempt = 0;
@@ -1246,9 +2210,12 @@ static void CMD_Set(ch9141_t *handle, char const *cmd)
         return;
     }
 
-    ModeSwitch(handle, MODE_AT);
+    ModeSwitch(handle, CH9141_IFC_MODE_AT);
     if (handle->error != CH9141_ERR_NONE)
+    {
+        CH9141_CacheInvalidate(handle);
         return;
+    }
 
     /* Clear RX buffer */
     memset(handle->rxBuf, '\0', sizeof(handle->rxBuf));
@@ -1257,49 +2224,29 @@ static void CMD_Set(ch9141_t *handle, char const *cmd)
     snprintf(handle->txBuf, sizeof(handle->txBuf), "%s\r\n", cmd);
 
     /* Send AT command */
-    if (handle->interface.transmit(handle->interface.handle, handle->txBuf, strlen(handle->txBuf)) !=
-        CH9141_ERROR_STATUS_SUCCESS)
+    if (Ifc_Transmit(handle, handle->txBuf, strlen(handle->txBuf)) != CH9141_ERROR_STATUS_SUCCESS)
     {
         handle->error = CH9141_ERR_SERIAL_TX;
-        ModeSwitch(handle, MODE_TRANSPARENT);
+        CH9141_CacheInvalidate(handle);
+        ModeSwitch(handle, CH9141_IFC_MODE_TRANSPARENT);
         return;
     }
 
     /* Get response */
-    if (handle->interface.receive(handle->interface.handle, handle->rxBuf, sizeof(handle->rxBuf), &handle->rxLen) !=
-        CH9141_ERROR_STATUS_SUCCESS)
+    if (!Response_Receive(handle, handle->rxBuf, sizeof(handle->rxBuf), &handle->rxLen))
     {
         handle->error = CH9141_ERR_SERIAL_RX;
-        ModeSwitch(handle, MODE_TRANSPARENT);
-        return;
-    }
-
-    /* Seek for `OK` in response message */
-    if (strstr(handle->rxBuf, successResponseTemplate) == NULL)
-    {
-        /* Unexpected response message */
-        handle->error = CH9141_ERR_RESPONSE;
-        ModeSwitch(handle, MODE_TRANSPARENT);
+        CH9141_CacheInvalidate(handle);
+        ModeSwitch(handle, CH9141_IFC_MODE_TRANSPARENT);
         return;
     }
 
-    /* Check for error message in the buffer */
-    if (strncmp(handle->rxBuf, errorResponseTemplate, strlen(errorResponseTemplate)) == 0)
+    /* Check response message */
+    Response_Check(handle);
+    if (handle->error != CH9141_ERR_NONE)
     {
-        /* Seek for the first digit in response message */
-        while (!isdigit(*pResponse))
-            if (*(pResponse++) == '\0')
-            {
-                /* Can't find any digit */
-                handle->error = CH9141_ERR_RESPONSE;
-                ModeSwitch(handle, MODE_TRANSPARENT);
-                return;
-            }
-
-        /* Convert msg->string->integer and fill the field within handle */
-        handle->error = CH9141_ERR_AT;
-        handle->errorAT = (ch9141_AT_Error_t) atoi(strtok(pResponse, "\r"));
-        ModeSwitch(handle, MODE_TRANSPARENT);
+        CH9141_CacheInvalidate(handle);
+        ModeSwitch(handle, CH9141_IFC_MODE_TRANSPARENT);
         return;
     }
 
@@ -1311,15 +2258,16 @@ static void CMD_Set(ch9141_t *handle, char const *cmd)
         {
             /* Get response */
             /* Use separated buffer, because driver rx buffer is used outside to keep the original cmd response */
-            if (handle->interface.receive(handle->interface.handle, response, sizeof(response), &responseLen) ==
-                CH9141_ERROR_STATUS_SUCCESS)
+            if (Response_Receive(handle, response, sizeof(response), &responseLen))
                 break;
+            STATS_INC(handle, retries);
         }
         if (!connectAttempt)
         {
             /* Run out of attempts to get the message from device */
             handle->error = CH9141_ERR_SERIAL_RX;
-            ModeSwitch(handle, MODE_TRANSPARENT);
+            CH9141_CacheInvalidate(handle);
+            ModeSwitch(handle, CH9141_IFC_MODE_TRANSPARENT);
             return;
         }
 
@@ -1328,120 +2276,738 @@ static void CMD_Set(ch9141_t *handle, char const *cmd)
         {
             /* Unexpected response message */
             handle->error = CH9141_ERR_RESPONSE;
-            ModeSwitch(handle, MODE_TRANSPARENT);
+            CH9141_CacheInvalidate(handle);
+            ModeSwitch(handle, CH9141_IFC_MODE_TRANSPARENT);
             return;
         }
     }
 
     /* Back to transparent mode, except for reset cmd */
     if (strncmp(cmd, "AT+RESET", strlen("AT+RESET")) != 0)
-        ModeSwitch(handle, MODE_TRANSPARENT);
+        ModeSwitch(handle, CH9141_IFC_MODE_TRANSPARENT);
 }
 
 /**
- * @brief Internal function used to reset the device after any setting command
+ * @brief Internal function used to get the configuration parameter, served from the cache if enabled and valid
  * @param handle pointer to the device handle
+ * @param cmd AT request, e.g. `AT+PNAME?`
  */
-static void Reset(ch9141_t *handle)
+static void CMD_GetCached(ch9141_t *handle, char const *cmd)
 {
-    char helloMsg[30] = {0};
-    uint16_t helloLen = 0;
+    int8_t key = Cache_Key(cmd);
 
     if (handle == NULL)
         return;
 
-    if (handle->interface.pinReset == NULL)
+    if (handle->cacheEn && (key >= 0) && (handle->cache.valid & (1u << key)))
     {
-        /* Set the parameter */
-        CMD_Set(handle, "AT+RESET");
-        if (handle->error != CH9141_ERR_NONE)
-            return;
+        strcpy(handle->rxBuf, handle->cache.value[key]);
+        handle->rxLen = strlen(handle->rxBuf);
+        handle->responseLen = handle->rxLen + 1;
+        return;
     }
-    else
+
+    CMD_Get(handle, cmd);
+    if (handle->error == CH9141_ERR_NONE)
+        Cache_Put(handle, key, handle->rxBuf);
+}
+
+/**
+ * @brief Internal function used to find the cache entry of the configuration parameter
+ * @param cmd AT request or setting command, e.g. `AT+PNAME?` or `AT+PNAME=name`
+ * @return Cache entry index, `-1` if the parameter is not cached
+ */
+static int8_t Cache_Key(char const *cmd)
+{
+    static char const *const keys[] = {"UART", "HELLO", "PNAME", "NAME", "SLEEP", "TPL",
+                                       "BLEMODE", "PASS", "MAC", "INITIO", "IOEN"};
+    size_t len;
+
+    if ((cmd == NULL) || (strncmp(cmd, "AT+", 3) != 0))
+        return -1;
+
+    cmd += 3;
+    len = strcspn(cmd, "?=");
+    for (uint8_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
     {
-        handle->interface.pinReset(CH9141_PIN_STATE_RESET);
-        handle->interface.delay(10);
-        handle->interface.pinReset(CH9141_PIN_STATE_SET);
+        if ((strlen(keys[i]) == len) && (strncmp(cmd, keys[i], len) == 0))
+            return i;
     }
 
-    /* Get potential hello message */
-    handle->interface.receive(handle->interface.handle, helloMsg, sizeof(helloMsg), &helloLen);
-    handle->interface.delay(300);
-    ModeSwitch(handle, MODE_TRANSPARENT);
+    return -1;
 }
 
 /**
- * @brief Internal function used to restore factory settings
+ * @brief Internal function used to keep the confirmed parameter value
  * @param handle pointer to the device handle
- * @note Device can be reloaded with two ways:
- *
- * 1. Through AT command
- *
- * 2. By pulling down `RELOAD/LED` pin for 2 sec after device is powered on
+ * @param key cache entry index
+ * @param value parameter value as the device responds it
  */
-static void Reload(ch9141_t *handle)
+static void Cache_Put(ch9141_t *handle, int8_t key, char const *value)
 {
-    char helloMsg[30] = {0};
-    uint16_t helloLen = 0;
-
-    if (handle == NULL)
+    if (!handle->cacheEn || (key < 0))
         return;
 
-    if (handle->interface.pinReload == NULL)
+    if (strlen(value) >= sizeof(handle->cache.value[key]))
     {
-        /* Set the parameter */
-        CMD_Set(handle, "AT+RELOAD");
-        if (handle->error != CH9141_ERR_NONE)
-            return;
+        handle->cache.valid &= ~(1u << key);
+        return;
     }
-    else
-    {
-        if (handle->interface.pinReset == NULL)
-        {
-            handle->error = CH9141_ERR_INTERFACE;
-            return;
-        }
 
-        handle->interface.pinReload(CH9141_PIN_STATE_RESET);
-        Reset(handle);
-        if (handle->error != CH9141_ERR_NONE)
-            return;
-        handle->interface.delay(2500);
-        handle->interface.pinReload(CH9141_PIN_STATE_SET);
+    strcpy(handle->cache.value[key], value);
+    handle->cache.valid |= 1u << key;
+}
 
-        /* Get potential hello message */
-        handle->interface.receive(handle->interface.handle, helloMsg, sizeof(helloMsg), &helloLen);
-        handle->interface.delay(300);
-        ModeSwitch(handle, MODE_TRANSPARENT);
-    }
+/**
+ * @brief Internal function used to keep the parameter value written by the accepted setting command
+ * @param handle pointer to the device handle
+ * @param cmd setting command, e.g. `AT+PNAME=name`. Its argument matches the get response of the parameter
+ */
+static void Cache_Store(ch9141_t *handle, char const *cmd)
+{
+    Cache_Put(handle, Cache_Key(cmd), strchr(cmd, '=') + 1);
 }
 
 /**
- * @brief Internal function used to check if the device is present and responsive by sending a simple AT command
+ * @brief Internal function used to receive AT command response
  * @param handle pointer to the device handle
- * @return `true` if device is present and responsive
+ * @param pDataRx pointer to the buffer where response will be saved
+ * @param size buffer size
+ * @param rxLen pointer to variable to keep the number of bytes actually received
+ * @return `true` if any data received
+ * @note Completes on response terminator if `interface.receiveResponse` is provided, otherwise on idle line
  */
-static bool Device_Check(ch9141_t *handle)
+static bool Response_Receive(ch9141_t *handle, char *pDataRx, uint16_t size, uint16_t *rxLen)
 {
     if (handle == NULL)
         return false;
 
-    softwareModeForce = true;
+    if (handle->interface.receiveResponse != NULL)
+        return Ifc_Receive(handle, CH9141_TRACE_RX_RESPONSE, pDataRx, size, rxLen) == CH9141_ERROR_STATUS_SUCCESS;
+
+    return Ifc_Receive(handle, CH9141_TRACE_RX, pDataRx, size, rxLen) == CH9141_ERROR_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Internal function used to call the platform transmit function
+ * @param handle pointer to the device handle
+ * @param pDataTx pointer to the data
+ * @param size number of bytes to send
+ * @return Status of the platform function
+ */
+static ch9141_ErrorStatus_t Ifc_Transmit(ch9141_t *handle, char const *pDataTx, uint16_t size)
+{
+    ch9141_ErrorStatus_t status = handle->interface.transmit(handle->interface.handle, pDataTx, size);
+
+#ifdef CH9141_TRACE
+    Trace_Put(handle, CH9141_TRACE_TX, status, pDataTx, size);
+#endif
+
+    return status;
+}
+
+/**
+ * @brief Internal function used to call the platform receive function
+ * @param handle pointer to the device handle
+ * @param kind receive function to call: `interface.receive`, `interface.receiveResponse` or `interface.receivePoll`
+ * @param pDataRx pointer to the buffer where data will be saved
+ * @param size buffer size
+ * @param rxLen pointer to variable to keep the number of bytes actually received
+ * @return Status of the platform function
+ */
+static ch9141_ErrorStatus_t Ifc_Receive(ch9141_t *handle, ch9141_TraceKind_t kind, char *pDataRx, uint16_t size,
+                                        uint16_t *rxLen)
+{
+    ch9141_ErrorStatus_t status;
+
+    switch (kind)
+    {
+    case CH9141_TRACE_RX_RESPONSE:
+        status = handle->interface.receiveResponse(handle->interface.handle, pDataRx, size, rxLen);
+        break;
+
+    case CH9141_TRACE_RX_POLL:
+        status = handle->interface.receivePoll(handle->interface.handle, pDataRx, size, rxLen);
+        break;
+
+    default:
+        status = handle->interface.receive(handle->interface.handle, pDataRx, size, rxLen);
+        break;
+    }
+
+#ifdef CH9141_TRACE
+    if ((kind != CH9141_TRACE_RX_POLL) || (*rxLen != 0))
+        Trace_Put(handle, kind, status, pDataRx, (*rxLen < size) ? *rxLen : size);
+#endif
+
+    return status;
+}
+
+/**
+ * @brief Internal function used to check AT command response in `rxBuf` for error or success message
+ * @param handle pointer to the device handle
+ */
+static void Response_Check(ch9141_t *handle)
+{
+    char const *successResponseTemplate = "OK\r\n";
+    char const *errorResponseTemplate = "\r\nERR:";
+    char *pResponse;
+
+    if (handle == NULL)
+        return;
+
+    pResponse = handle->rxBuf;
+
+    /* Check for error message in the buffer. It is not followed by `OK` */
+    if (strncmp(handle->rxBuf, errorResponseTemplate, strlen(errorResponseTemplate)) == 0)
+    {
+        /* Seek for the first digit in response message */
+        while (!isdigit((unsigned char) *pResponse))
+            if (*(pResponse++) == '\0')
+            {
+                /* Can't find any digit */
+                handle->error = CH9141_ERR_RESPONSE;
+                return;
+            }
+
+        /* Convert msg->string->integer and fill the field within handle */
+        handle->error = CH9141_ERR_AT;
+        handle->errorAT = (ch9141_AT_Error_t) atoi(pResponse);
+#ifdef CH9141_STATS
+        handle->stats.errorsAT[(handle->errorAT < CH9141_AT_ERR_NUM) ? handle->errorAT : CH9141_AT_ERR_NONE]++;
+#endif
+        return;
+    }
+
+    /* Seek for `OK` in response message */
+    if (strstr(handle->rxBuf, successResponseTemplate) == NULL)
+    {
+        /* Unexpected response message */
+        handle->error = CH9141_ERR_RESPONSE;
+        return;
+    }
+}
+
+/**
+ * @brief Internal function used to retrieve the parameter value from the whole get command response in `rxBuf`
+ * @param handle pointer to the device handle
+ */
+static void Response_Trim(ch9141_t *handle)
+{
+    char *pResponseEnd;
+
+    if (handle == NULL)
+        return;
+
+    pResponseEnd = strchr(handle->rxBuf, '\r');
+    if (pResponseEnd == NULL)
+    {
+        /* Unexpected response message - `\r` token not found */
+        handle->error = CH9141_ERR_RESPONSE;
+        return;
+    }
+    *pResponseEnd = '\0';
+
+    /* Update response length field */
+    handle->responseLen = strlen(handle->rxBuf) + 1;
+}
+
+/**
+ * @brief Internal function used to parse serial interface parameters response, e.g. `115200,8,1,0,50`
+ * @param pResponse pointer to the trimmed response
+ * @param serial pointer to the structure to fill
+ * @return `true` if the response is well-formed
+ */
+static bool Serial_Parse(char const *pResponse, ch9141_SerialCfg_t *serial)
+{
+    uint32_t field[5];
+    char *pEnd;
+
+    for (uint8_t i = 0; i < sizeof(field) / sizeof(field[0]); i++)
+    {
+        if (!isdigit((unsigned char) *pResponse))
+            return false;
+        field[i] = strtoul(pResponse, &pEnd, 10);
+        if (*pEnd != ((i < sizeof(field) / sizeof(field[0]) - 1) ? ',' : '\0'))
+            return false;
+        pResponse = pEnd + 1;
+    }
+
+    serial->baudRate = field[0];
+    serial->dataBit = field[1];
+    serial->stopBit = field[2];
+    serial->parity = (ch9141_SerialParity_t) field[3];
+    serial->timeout = field[4];
+
+    return true;
+}
+
+/**
+ * @brief Internal function used to parse MAC address response, e.g. `05:DF:39:4C:99:B4`
+ * @param pResponse pointer to the trimmed response
+ * @param mac pointer to the structure to fill
+ * @return `true` if the response is well-formed
+ */
+static bool MAC_Parse(char const *pResponse, ch9141_MAC_t *mac)
+{
+    for (uint8_t i = 0; i < sizeof(mac->addr); i++, pResponse += 3)
+    {
+        if (!isxdigit((unsigned char) pResponse[0]) || !isxdigit((unsigned char) pResponse[1]) ||
+            (pResponse[2] != ((i < sizeof(mac->addr) - 1) ? ':' : '\0')))
+            return false;
+        mac->addr[i] = (uint8_t) strtoul(pResponse, NULL, 16);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Internal function used to take the name response
+ * @param pResponse pointer to the trimmed response
+ * @param name pointer to the structure to fill
+ * @return `true` if the name fits the structure
+ */
+static bool Name_Parse(char const *pResponse, ch9141_Name_t *name)
+{
+    if (strlen(pResponse) >= sizeof(name->str))
+        return false;
+
+    strcpy(name->str, pResponse);
+
+    return true;
+}
+
+/**
+ * @brief Internal function used to reset the device after any setting command
+ * @param handle pointer to the device handle
+ */
+static void Reset(ch9141_t *handle)
+{
+    Reset_Baud(handle, 0);
+}
+
+/**
+ * @brief Internal function used to reset the device which boots with the new baudrate
+ * @param handle pointer to the target device handle
+ * @param baudRate host UART baudrate set right after the reset is issued, `0` to keep the current one
+ */
+static void Reset_Baud(ch9141_t *handle, uint32_t baudRate)
+{
+    if (handle == NULL)
+        return;
+
+    STATS_INC(handle, resets);
+
+    if (handle->interface.pinReset == NULL)
+    {
+        /* Set the parameter */
+        CMD_Set(handle, "AT+RESET");
+        if (handle->error != CH9141_ERR_NONE)
+            return;
+    }
+    else
+    {
+        handle->interface.pinReset(CH9141_PIN_STATE_RESET);
+        handle->interface.delay(10);
+        handle->interface.pinReset(CH9141_PIN_STATE_SET);
+    }
+
+    /* Software AT mode is lost after reset, so it has to be entered again within the session. Hardware one is kept by
+     * the mode pin level */
+    if ((handle->interface.pinMode == NULL) || handle->softwareModeForce)
+        handle->sessionAT = false;
+
+    /* Any reset takes effect of all postponed settings */
+    handle->resetPending = false;
+
+    /* Device boots with the new baudrate */
+    if ((baudRate != 0) && (handle->interface.baudSet != NULL) && !Baud_Set(handle, baudRate))
+    {
+        handle->error = CH9141_ERR_INTERFACE;
+        return;
+    }
+
+    /* Device is ready as soon as hello message is sent or AT command is answered */
+    if (!Hello_Wait(handle))
+        Ready_Wait(handle, CH9141_READY_TIMEOUT_BOOT);
+
+    /* Device boots in transparent mode, only the mode pin has to be released */
+    if ((handle->interface.pinMode != NULL) && !handle->softwareModeForce)
+        ModeSwitch(handle, CH9141_IFC_MODE_TRANSPARENT);
+}
+
+/**
+ * @brief Internal function used to reset the device after any setting command or to postpone the reset until
+ * `CH9141_Commit` is called in deferred reset mode
+ * @param handle pointer to the device handle
+ */
+static void Reset_Apply(ch9141_t *handle)
+{
+    if (handle == NULL)
+        return;
+
+    if (handle->resetDefer)
+    {
+        handle->resetPending = true;
+        return;
+    }
+
+    Reset(handle);
+}
+
+/**
+ * @brief Internal function used to restore factory settings
+ * @param handle pointer to the device handle
+ * @note Device can be reloaded with two ways:
+ *
+ * 1. Through AT command
+ *
+ * 2. By pulling down `RELOAD/LED` pin for 2 sec after device is powered on
+ */
+static void Reload(ch9141_t *handle)
+{
+    if (handle == NULL)
+        return;
+
+    STATS_INC(handle, reloads);
+
+    /* Factory settings replace all the known values */
+    CH9141_CacheInvalidate(handle);
+    handle->helloOff = false;
+
+    if (handle->interface.pinReload == NULL)
+    {
+        /* Set the parameter */
+        CMD_Set(handle, "AT+RELOAD");
+        if (handle->error != CH9141_ERR_NONE)
+            return;
+
+        /* Factory baudrate takes effect after reset, the host follows it */
+        if ((handle->baudRate != 0) && (handle->baudRate != CH9141_BAUD_FACTORY))
+            Reset_Baud(handle, CH9141_BAUD_FACTORY);
+    }
+    else
+    {
+        if (handle->interface.pinReset == NULL)
+        {
+            handle->error = CH9141_ERR_INTERFACE;
+            return;
+        }
+
+        handle->interface.pinReload(CH9141_PIN_STATE_RESET);
+        Reset(handle);
+        if (handle->error != CH9141_ERR_NONE)
+            return;
+
+        /* `Reset` returns after the boot, so the hold time is counted from the power on */
+        handle->interface.delay(CH9141_RELOAD_HOLD);
+        handle->interface.pinReload(CH9141_PIN_STATE_SET);
+
+        /* Device reboots with factory settings */
+        if ((handle->interface.baudSet != NULL) && !Baud_Set(handle, CH9141_BAUD_FACTORY))
+        {
+            handle->error = CH9141_ERR_INTERFACE;
+            return;
+        }
+        if (!Hello_Wait(handle))
+            Ready_Wait(handle, CH9141_READY_TIMEOUT_BOOT);
+        ModeSwitch(handle, CH9141_IFC_MODE_TRANSPARENT);
+    }
+}
+
+/**
+ * @brief Internal function used to wait for the hello message sent by the device after boot
+ * @param handle pointer to the device handle
+ * @return `true` if hello message is received, so the device is ready
+ * @note Takes the receive timeout if hello message is disabled. Skipped once it is known to be disabled (see
+ * `helloOff`)
+ */
+static bool Hello_Wait(ch9141_t *handle)
+{
+    char helloMsg[30] = {0};
+    uint16_t helloLen = 0;
+
+    if (handle == NULL)
+        return false;
+
+    if (handle->helloOff)
+        return false;
+
+    return (Ifc_Receive(handle, CH9141_TRACE_RX, helloMsg, sizeof(helloMsg), &helloLen) ==
+            CH9141_ERROR_STATUS_SUCCESS) &&
+           (helloLen != 0);
+}
+
+/**
+ * @brief Internal function used to wait for the device readiness by probing it with a simple AT command. Interval
+ * between probes is doubled each time until the timeout is reached
+ * @param handle pointer to the device handle
+ * @param timeout [ms]. Max time to wait. Receive timeout of an unanswered probe stands for the interval after it
+ * @return `true` if device answered
+ * @note Probing is done in hardware AT mode only, since each software AT mode enter costs 500mS. Without mode pin the
+ * whole timeout is waited
+ * @note Hello message is taken as the answer. Probe sent while the device boots is dropped, the hello message comes
+ * back instead of its response
+ */
+static bool Ready_Wait(ch9141_t *handle, uint32_t timeout)
+{
+    char response[30];
+    uint16_t responseLen;
+    bool probed;
+    uint32_t waited = 0;
+    bool ready = false;
+
+    if (handle == NULL)
+        return false;
+
+    if ((handle->interface.pinMode == NULL) || handle->softwareModeForce)
+    {
+        handle->interface.delay(timeout);
+        return false;
+    }
+
+    ModeSwitch(handle, CH9141_IFC_MODE_AT);
+    for (uint32_t backoff = CH9141_READY_BACKOFF;; backoff *= 2)
+    {
+        /* Reception is completed by the idle line instead of AT response terminator, so the hello message is not
+         * waited beyond itself */
+        memset(response, 0, sizeof(response));
+        responseLen = 0;
+        snprintf(handle->txBuf, sizeof(handle->txBuf), "AT...\r\n");
+        probed = Ifc_Transmit(handle, handle->txBuf, strlen(handle->txBuf)) == CH9141_ERROR_STATUS_SUCCESS;
+        if (probed &&
+            (Ifc_Receive(handle, CH9141_TRACE_RX, response, sizeof(response) - 1, &responseLen) ==
+             CH9141_ERROR_STATUS_SUCCESS) &&
+            (responseLen >= 2) && (strcmp(&response[responseLen - 2], "\r\n") == 0))
+        {
+            ready = true;
+            break;
+        }
+
+        /* Device is not ready yet - not an error */
+        if (waited >= timeout)
+            break;
+
+        if (backoff > timeout - waited)
+            backoff = timeout - waited;
+        /* Unanswered probe has already taken the receive timeout */
+        if (!probed || (responseLen != 0))
+            handle->interface.delay(backoff);
+        waited += backoff;
+    }
+    ModeSwitch(handle, CH9141_IFC_MODE_TRANSPARENT);
+
+    return ready;
+}
+
+/**
+ * @brief Internal function used to start asynchronous AT command execution
+ * @param handle pointer to the device handle
+ * @param op operation being started
+ * @param cmd AT command. Should be null-terminated string
+ * @return Status of the request
+ */
+static ch9141_ErrorStatus_t Async_Start(ch9141_t *handle, ch9141_State_t op, char const *cmd)
+{
+    if (handle == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Operation in progress owns the handle error, AT session owns the device mode */
+    if (handle->async.active || handle->session)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Check any existing errors */
+    if (handle->error != CH9141_ERR_NONE)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    if (handle->interface.receivePoll == NULL)
+        return Async_Reject(handle, CH9141_ERR_INTERFACE);
+
+    /* Set operational state */
+    handle->state = op;
+
+    /* Add trailing symbols to message and pass to the tx buffer */
+    snprintf(handle->txBuf, sizeof(handle->txBuf), "%s\r\n", cmd);
+
+    handle->async.active = true;
+    handle->async.op = op;
+    handle->async.step = ASYNC_STEP_AT_ENTER;
+    handle->async.error = CH9141_ERR_NONE;
+    handle->async.value = 0;
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Internal function used to refuse the asynchronous request
+ * @param handle pointer to the device handle
+ * @param error reason of the refusal, reported unless another operation is in progress
+ * @return Error status
+ */
+static ch9141_ErrorStatus_t Async_Reject(ch9141_t *handle, ch9141_Error_t error)
+{
+    if (!handle->async.active)
+        handle->error = error;
+
+    return CH9141_ERROR_STATUS_ERROR;
+}
+
+/**
+ * @brief Internal function used to refuse the synchronous request while asynchronous operation is in progress
+ * @param handle pointer to the device handle
+ * @return `true` if the request is refused with `CH9141_ERR_BUSY`
+ */
+static bool Async_Busy(ch9141_t *handle)
+{
+    if (!handle->async.active)
+        return false;
+
+    handle->error = CH9141_ERR_BUSY;
+
+    return true;
+}
+
+/**
+ * @brief Internal function used to append the data received so far
+ * @param handle pointer to the device handle
+ * @param pDataRx pointer to the buffer, kept null-terminated
+ * @param size buffer size
+ * @param rxLen pointer to the number of bytes already in the buffer
+ * @return `true` if the response is complete or buffer is full
+ */
+static bool Async_Receive(ch9141_t *handle, char *pDataRx, uint16_t size, uint16_t *rxLen)
+{
+    uint16_t len = 0;
+
+    if (Ifc_Receive(handle, CH9141_TRACE_RX_POLL, &pDataRx[*rxLen], size - 1 - *rxLen, &len) ==
+        CH9141_ERROR_STATUS_SUCCESS)
+        *rxLen += len;
+    pDataRx[*rxLen] = '\0';
+
+    return CH9141_ResponseIsComplete(pDataRx, *rxLen) || (*rxLen == size - 1);
+}
+
+/**
+ * @brief Internal function used to drop any data received before the request
+ * @param handle pointer to the device handle
+ */
+static void Async_Flush(ch9141_t *handle)
+{
+    char dummy[16];
+    uint16_t len = 0;
+
+    while ((Ifc_Receive(handle, CH9141_TRACE_RX_POLL, dummy, sizeof(dummy), &len) == CH9141_ERROR_STATUS_SUCCESS) &&
+           (len != 0))
+        ;
+}
+
+/**
+ * @brief Internal function used to send the request and prepare response reception
+ * @param handle pointer to the device handle
+ * @param pDataTx null-terminated request
+ * @param now current time [ms]
+ * @return `true` if the request is sent
+ */
+static bool Async_Transmit(ch9141_t *handle, char const *pDataTx, uint32_t now)
+{
+    Async_Flush(handle);
+    if (Ifc_Transmit(handle, pDataTx, strlen(pDataTx)) != CH9141_ERROR_STATUS_SUCCESS)
+        return false;
+
+    handle->async.responseLen = 0;
+    handle->async.response[0] = '\0';
+    handle->async.deadline = now + CH9141_ASYNC_TIMEOUT;
+
+    return true;
+}
+
+/**
+ * @brief Internal function used to complete asynchronous operation: parse the result and report it
+ * @param handle pointer to the device handle
+ */
+static void Async_Finish(ch9141_t *handle)
+{
+    ch9141_State_t op = handle->async.op;
+
+    /* Refusal of synchronous requests made meanwhile is superseded by the result */
+    handle->error = handle->async.error;
+
+    /* Retrieve getter result */
+    if (handle->error == CH9141_ERR_NONE)
+    {
+        switch (op)
+        {
+        case CH9141_STATE_STATUS_GET:
+        case CH9141_STATE_VCC_GET:
+        case CH9141_STATE_ADC_GET:
+            Response_Trim(handle);
+            handle->async.value = atoi(handle->rxBuf);
+            break;
+
+        case CH9141_STATE_GPIO_GET:
+            /* Map response message with ch9141_PinState_t */
+            Response_Trim(handle);
+            switch (atoi(handle->rxBuf))
+            {
+            case 0:
+                handle->async.value = CH9141_PIN_STATE_RESET;
+                break;
+
+            case 1:
+                handle->async.value = CH9141_PIN_STATE_SET;
+                break;
+
+            default:
+                handle->async.value = CH9141_PIN_STATE_UNDEFINED;
+                break;
+            }
+            break;
+
+        case CH9141_STATE_MAC_REMOTE_GET:
+            Response_Trim(handle);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    /* Set operational state */
+    if (handle->error == CH9141_ERR_NONE)
+        handle->state = CH9141_STATE_IDLE;
+
+    handle->async.active = false;
+    if (handle->asyncDone != NULL)
+        handle->asyncDone(handle, op);
+}
+
+/**
+ * @brief Internal function used to check if the device is present and responsive by sending a simple AT command
+ * @param handle pointer to the device handle
+ * @return `true` if device is present and responsive
+ */
+static bool Device_Check(ch9141_t *handle)
+{
+    if (handle == NULL)
+        return false;
+
+    handle->softwareModeForce = true;
     for (uint8_t attempt = 0; attempt < 2; ++attempt)
     {
         CMD_Get(handle, "AT...");
         if (handle->error == CH9141_ERR_NONE && strcmp(handle->rxBuf, "OK") == 0)
         {
-            softwareModeForce = false;
+            handle->softwareModeForce = false;
             return true;
         }
 
         handle->error = CH9141_ERR_NONE;
+        STATS_INC(handle, retries);
         Reset(handle);
     }
 
     handle->error = CH9141_ERR_NO_DEVICE;
-    softwareModeForce = false;
+    handle->softwareModeForce = false;
     return false;
 }
 
@@ -1461,27 +3027,281 @@ static bool ModePin_Check(ch9141_t *handle)
         return true;
 
     /* Check AT mode */
-    modeForce = MODE_AT;
+    handle->modeForce = CH9141_IFC_MODE_AT;
     CMD_Get(handle, "AT...");
     if (handle->error != CH9141_ERR_NONE || strcmp(handle->rxBuf, "OK") != 0)
     {
-        modeForce = MODE_UNDEFINED;
+        handle->modeForce = CH9141_IFC_MODE_UNDEFINED;
         handle->error = CH9141_ERR_PIN_MODE;
         return false;
     }
 
     /* Check Transparent mode */
     /* Device should NOT response */
-    modeForce = MODE_TRANSPARENT;
+    handle->modeForce = CH9141_IFC_MODE_TRANSPARENT;
     CMD_Get(handle, "AT...");
     if (handle->error == CH9141_ERR_NONE && strcmp(handle->rxBuf, "OK") == 0)
     {
-        modeForce = MODE_UNDEFINED;
+        handle->modeForce = CH9141_IFC_MODE_UNDEFINED;
         handle->error = CH9141_ERR_PIN_MODE;
         return false;
     }
 
-    modeForce = MODE_UNDEFINED;
+    handle->modeForce = CH9141_IFC_MODE_UNDEFINED;
     handle->error = CH9141_ERR_NONE;
     return true;
 }
+
+/**
+ * @brief Internal function used to reconfigure the host UART
+ * @param handle pointer to the device handle
+ * @param baudRate new baudrate
+ * @return `true` if the host UART supports the baudrate
+ */
+static bool Baud_Set(ch9141_t *handle, uint32_t baudRate)
+{
+    if (handle->interface.baudSet(handle->interface.handle, baudRate) != CH9141_ERROR_STATUS_SUCCESS)
+        return false;
+
+    handle->baudRate = baudRate;
+
+    return true;
+}
+
+/**
+ * @brief Internal function used to wait for the device to get ready at any of the candidate baudrates
+ * @param handle pointer to the device handle
+ * @param timeout [ms]. Max time to wait
+ * @return `true` if the device has answered. The host UART is left at the baudrate it has answered at, otherwise at
+ * the first candidate
+ * @note Candidates are swept on the doubling backoff as in `Ready_Wait`, each miss takes the receive timeout
+ * @note Software AT mode is entered only after the device is ready, so the sweep is made once after the timeout,
+ * which is the idle line the first enter requires. Probe at a wrong baudrate is taken by the device as data, so each
+ * next candidate waits for the idle line again, counted from the previous probe if `interface.tick` is provided. A
+ * miss costs up to 500mS and the receive timeout then, order the candidates by likelihood
+ */
+static bool Baud_Detect(ch9141_t *handle, uint32_t timeout)
+{
+    bool software = (handle->interface.pinMode == NULL) || handle->softwareModeForce;
+    uint32_t waited = 0;
+    bool probed = false;
+    uint32_t probeAt = 0;
+    uint32_t elapsed;
+    char response[10];
+    uint16_t responseLen;
+
+    if (software)
+    {
+        handle->interface.delay(timeout);
+
+        for (uint8_t i = 0; i < handle->baudCandidatesNum; i++)
+        {
+            if (!Baud_Set(handle, handle->baudCandidates[i]))
+                continue;
+
+            /* Line is idle since the previous probe */
+            if (probed)
+            {
+                elapsed = (handle->interface.tick != NULL) ? handle->interface.tick() - probeAt : 0;
+                if (elapsed < CH9141_AT_IDLE)
+                    handle->interface.delay(CH9141_AT_IDLE - elapsed);
+            }
+
+            /* Software AT mode enter without the idle line wait of `ModeSwitch` */
+            STATS_INC(handle, modeSwitches);
+            memset(response, 0, sizeof(response));
+            responseLen = 0;
+            probed = true;
+            probeAt = (handle->interface.tick != NULL) ? handle->interface.tick() : 0;
+            snprintf(handle->txBuf, sizeof(handle->txBuf), "AT...\r\n");
+            if ((Ifc_Transmit(handle, handle->txBuf, strlen(handle->txBuf)) == CH9141_ERROR_STATUS_SUCCESS) &&
+                Response_Receive(handle, response, sizeof(response), &responseLen) &&
+                (strncmp(response, "OK\r\n", 4) == 0))
+            {
+                ModeSwitch(handle, CH9141_IFC_MODE_TRANSPARENT);
+                if (handle->error == CH9141_ERR_NONE)
+                    return true;
+
+                handle->error = CH9141_ERR_NONE;
+            }
+        }
+        Baud_Set(handle, handle->baudCandidates[0]);
+
+        return false;
+    }
+
+    for (uint32_t backoff = CH9141_READY_BACKOFF;; backoff *= 2)
+    {
+        for (uint8_t i = 0; i < handle->baudCandidatesNum; i++)
+        {
+            if (!Baud_Set(handle, handle->baudCandidates[i]))
+                continue;
+
+            CMD_Get(handle, "AT...");
+            if (handle->error == CH9141_ERR_NONE && strcmp(handle->rxBuf, "OK") == 0)
+                return true;
+
+            /* No answer at this baudrate - not an error */
+            handle->error = CH9141_ERR_NONE;
+            handle->errorAT = CH9141_AT_ERR_NONE;
+        }
+        if (waited >= timeout)
+            break;
+
+        if (backoff > timeout - waited)
+            backoff = timeout - waited;
+        handle->interface.delay(backoff);
+        waited += backoff;
+    }
+
+    Baud_Set(handle, handle->baudCandidates[0]);
+
+    return false;
+}
+
+/**
+ * @brief Internal function used to write the device baudrate and reset the device with the host UART retuned
+ * @param handle pointer to the device handle
+ * @param baudRate new baudrate
+ * @param serial the rest of serial parameters as returned by `AT+UART?`, starting from the comma
+ * @return `true` if the device has accepted the baudrate. Any error is cleared
+ */
+static bool Baud_Write(ch9141_t *handle, uint32_t baudRate, char const *serial)
+{
+    char cmd[30] = {0};
+
+    snprintf(cmd, sizeof(cmd), "AT+UART=%lu%s", (unsigned long) baudRate, serial);
+    CMD_Set(handle, cmd);
+    if (handle->error != CH9141_ERR_NONE)
+    {
+        handle->error = CH9141_ERR_NONE;
+        handle->errorAT = CH9141_AT_ERR_NONE;
+        return false;
+    }
+
+    Reset_Baud(handle, baudRate);
+    handle->error = CH9141_ERR_NONE;
+    handle->errorAT = CH9141_AT_ERR_NONE;
+
+    return true;
+}
+
+/**
+ * @brief Internal function used to check the device communicates at the provided baudrate
+ * @param handle pointer to the device handle
+ * @param baudRate expected baudrate
+ * @return `true` if the device reports the expected baudrate. Any error is cleared
+ */
+static bool Baud_Verify(ch9141_t *handle, uint32_t baudRate)
+{
+    CMD_Get(handle, "AT+UART?");
+    if ((handle->error == CH9141_ERR_NONE) && (strtoul(handle->rxBuf, NULL, 10) == baudRate))
+        return true;
+
+    handle->error = CH9141_ERR_NONE;
+    handle->errorAT = CH9141_AT_ERR_NONE;
+
+    return false;
+}
+
+#ifdef CH9141_STATS
+/**
+ * @brief Internal function used to account the completed AT command exchange
+ * @param handle pointer to the device handle
+ * @param op operation the exchange belongs to
+ * @param error exchange result
+ * @param elapsed [ms]. Exchange duration, `UINT32_MAX` if not measured
+ */
+static void Stats_Exchange(ch9141_t *handle, ch9141_State_t op, ch9141_Error_t error, uint32_t elapsed)
+{
+    ch9141_StatsOp_t *pOp;
+
+    if (op >= CH9141_STATE_NUM)
+        return;
+
+    pOp = &handle->stats.op[op];
+    pOp->count++;
+    if (error != CH9141_ERR_NONE)
+    {
+        pOp->errors++;
+        if (error < CH9141_ERR_NUM)
+            handle->stats.errors[error]++;
+    }
+
+    if (elapsed == UINT32_MAX)
+        return;
+    if ((pOp->count == 1) || (elapsed < pOp->min))
+        pOp->min = elapsed;
+    if (elapsed > pOp->max)
+        pOp->max = elapsed;
+    pOp->total += elapsed;
+}
+#endif
+
+#ifdef CH9141_TRACE
+/**
+ * @brief Internal function used to append the record to the wire trace, overwriting the oldest ones if needed
+ * @param handle pointer to the device handle
+ * @param kind interface function called
+ * @param status status returned by the interface function
+ * @param pData pointer to the data transmitted or received
+ * @param len number of bytes transmitted or received
+ */
+static void Trace_Put(ch9141_t *handle, ch9141_TraceKind_t kind, ch9141_ErrorStatus_t status, char const *pData,
+                      uint16_t len)
+{
+    ch9141_TraceRecord_t record = {0};
+    ch9141_TraceRecord_t oldest;
+    uint16_t size;
+    uint32_t tail;
+
+    record.time = (handle->interface.tick != NULL) ? handle->interface.tick() : 0;
+    record.len = (len < CH9141_TRACE_PAYLOAD_MAX) ? len : CH9141_TRACE_PAYLOAD_MAX;
+    record.kind = kind;
+    record.ok = status == CH9141_ERROR_STATUS_SUCCESS;
+    record.state = handle->state;
+    size = sizeof(record) + record.len;
+    if (size > sizeof(handle->trace.data))
+        return;
+
+    /* Make room for the record */
+    while (handle->trace.used + size > sizeof(handle->trace.data))
+    {
+        Trace_Read(handle, handle->trace.head, &oldest, sizeof(oldest));
+        handle->trace.head = (handle->trace.head + sizeof(oldest) + oldest.len) % sizeof(handle->trace.data);
+        handle->trace.used -= sizeof(oldest) + oldest.len;
+        handle->trace.dropped++;
+    }
+
+    tail = (handle->trace.head + handle->trace.used) % sizeof(handle->trace.data);
+    Trace_Write(handle, tail, &record, sizeof(record));
+    Trace_Write(handle, (tail + sizeof(record)) % sizeof(handle->trace.data), pData, record.len);
+    handle->trace.used += size;
+}
+
+/**
+ * @brief Internal function used to copy the data out of the wire trace ring
+ * @param handle pointer to the device handle
+ * @param offset ring offset to start from
+ * @param pData pointer to the destination
+ * @param size number of bytes to copy
+ */
+static void Trace_Read(ch9141_t const *handle, uint32_t offset, void *pData, uint16_t size)
+{
+    for (uint16_t i = 0; i < size; i++)
+        ((uint8_t *) pData)[i] = handle->trace.data[(offset + i) % sizeof(handle->trace.data)];
+}
+
+/**
+ * @brief Internal function used to copy the data into the wire trace ring
+ * @param handle pointer to the device handle
+ * @param offset ring offset to start from
+ * @param pData pointer to the source
+ * @param size number of bytes to copy
+ */
+static void Trace_Write(ch9141_t *handle, uint32_t offset, void const *pData, uint16_t size)
+{
+    for (uint16_t i = 0; i < size; i++)
+        handle->trace.data[(offset + i) % sizeof(handle->trace.data)] = ((uint8_t const *) pData)[i];
+}
+#endif
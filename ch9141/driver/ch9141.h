@@ -7,6 +7,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef CH9141_TRACE_SIZE
+#define CH9141_TRACE_SIZE 1024 // [bytes]. Wire trace ring size, used if `CH9141_TRACE` is defined
+#endif
+#define CH9141_TRACE_PAYLOAD_MAX 64 // [bytes]. Longer transfers are traced truncated
+
 /* Custom data types */
 typedef enum ch9141_ErrorStatus_e { CH9141_ERROR_STATUS_SUCCESS = 10, CH9141_ERROR_STATUS_ERROR } ch9141_ErrorStatus_t;
 
@@ -27,7 +32,9 @@ typedef enum ch9141_Error_e {
     CH9141_ERR_RESPONSE,
     CH9141_ERR_INTERFACE,
     CH9141_ERR_NO_DEVICE,
-    CH9141_ERR_PIN_MODE
+    CH9141_ERR_PIN_MODE,
+    CH9141_ERR_BUSY, // Synchronous request is refused while asynchronous operation is in progress
+    CH9141_ERR_NUM // Number of error codes, not an error
 } ch9141_Error_t;
 
 typedef enum ch9141_AT_Error_e {
@@ -35,7 +42,8 @@ typedef enum ch9141_AT_Error_e {
     CH9141_AT_ERR_CACHE, // The current chip does not have a cache to respond, you can try again later
     CH9141_AT_ERR_PARAM, // Some parameters of the AT command that is sent do not meet the specifications
     CH9141_AT_ERR_CMD_SUP, // Commands are not supported in the current mode
-    CH9141_AT_ERR_CMD_EXEC // The command cannot be executed temporarily
+    CH9141_AT_ERR_CMD_EXEC, // The command cannot be executed temporarily
+    CH9141_AT_ERR_NUM // Custom - number of error codes, not an error
 } ch9141_AT_Error_t;
 
 typedef enum ch9141_Mode_e {
@@ -92,7 +100,14 @@ typedef enum ch9141_State_e {
     CH9141_STATE_GPIO_INIT_GET,
     CH9141_STATE_GPIO_INIT_SET,
     CH9141_STATE_GPIO_EN_GET,
-    CH9141_STATE_GPIO_EN_SET
+    CH9141_STATE_GPIO_EN_SET,
+    CH9141_STATE_SESSION_BEGIN,
+    CH9141_STATE_SESSION_END,
+    CH9141_STATE_RESET_DEFER,
+    CH9141_STATE_COMMIT,
+    CH9141_STATE_APPLY,
+    CH9141_STATE_BAUD_NEGOTIATE,
+    CH9141_STATE_NUM // Number of states, not a state
 } ch9141_State_t;
 
 typedef enum ch9141_Power_e {
@@ -118,6 +133,105 @@ typedef enum ch9141_BLEStatus_e {
     CH9141_BLESTAT_ERROR
 } ch9141_BLEStatus_t;
 
+typedef enum ch9141_IfcMode_e {
+    CH9141_IFC_MODE_UNDEFINED,
+    CH9141_IFC_MODE_AT, // Device accepts AT commands
+    CH9141_IFC_MODE_TRANSPARENT // Device forwards serial data to the connected BLE device
+} ch9141_IfcMode_t;
+
+/* Serial interface parameters */
+typedef struct ch9141_SerialCfg_s {
+    uint32_t baudRate; // Baudrate (up 1Mbit/s)
+    uint8_t dataBit; // Data bits (8 or 9)
+    uint8_t stopBit; // Stop bits (1 or 2)
+    ch9141_SerialParity_t parity; // Parity (none, odd or even)
+    uint16_t timeout; // [ms]. Timeout in transparent transmission mode
+} ch9141_SerialCfg_t;
+
+/* BLE MAC address */
+typedef struct ch9141_MAC_s {
+    uint8_t addr[6]; // In the order the address is written, e.g. `addr[0]` is `0x05` for `05:DF:39:4C:99:B4`
+} ch9141_MAC_t;
+
+/* Device or chip name */
+typedef struct ch9141_Name_s {
+    char str[19]; // Null-terminated, up to 18 characters
+} ch9141_Name_t;
+
+/* Desired device configuration. Any parameter can be skipped to keep its current value. Zero is a valid value for the
+ * most of them, so start from `CH9141_CONFIG_KEEP` and assign the ones to be set */
+typedef struct ch9141_Config_s {
+    char const *deviceName; // Device name (up to 18 characters) or `NULL` to skip
+    char const *chipName; // Chip name (up to 18 characters) or `NULL` to skip
+    char const *hello; // Welcome message (up to 29 characters) or `NULL` to skip
+    char const *password; // Slave password (6 numeric characters) or `NULL` to skip
+    ch9141_FuncState_t passwordState; // Password check state, written along with the password
+    ch9141_Power_t power; // BLE transmission power or `CH9141_POWER_UNDEFINED` to skip
+    ch9141_SleepMode_t sleepMode; // Sleep mode or `CH9141_SLEEPMODE_UNDEFINED` to skip
+    ch9141_Mode_t mode; // BLE working mode or `CH9141_MODE_UNDEFINED` to skip
+    uint16_t gpioEn; // GPIO enable config byte or `UINT16_MAX` to skip
+    uint16_t gpioInit; // Default value of GPIO output (byte bitmask) or `UINT16_MAX` to skip
+    struct {
+        uint32_t baudRate; // Baudrate (up 1Mbit/s) or `0` to skip the whole serial interface configuration
+        uint8_t dataBit; // Data bits (8 or 9)
+        uint8_t stopBit; // Stop bits (1 or 2)
+        ch9141_SerialParity_t parity; // Parity (none, odd or even)
+        uint16_t timeout; // [ms]. Timeout in transparent transmission mode
+    } serial;
+} ch9141_Config_t;
+
+/* Configuration skipping every parameter */
+#define CH9141_CONFIG_KEEP                                                                                             \
+    {                                                                                                                  \
+        .deviceName = NULL, .chipName = NULL, .hello = NULL, .password = NULL,                                        \
+        .passwordState = CH9141_FUNC_STATE_ENABLE, .power = CH9141_POWER_UNDEFINED,                                    \
+        .sleepMode = CH9141_SLEEPMODE_UNDEFINED, .mode = CH9141_MODE_UNDEFINED, .gpioEn = UINT16_MAX,                  \
+        .gpioInit = UINT16_MAX, .serial = {.baudRate = 0}                                                              \
+    }
+
+/* AT command exchange statistics of the single operation */
+typedef struct ch9141_StatsOp_s {
+    uint32_t count; // Number of AT commands exchanged
+    uint32_t errors; // Number of failed exchanges
+    uint32_t min; // [ms]. Shortest exchange
+    uint32_t max; // [ms]. Longest exchange
+    uint32_t total; // [ms]. Sum of all exchanges, mean is `total / count`
+} ch9141_StatsOp_t;
+
+/* Driver statistics. Collected if `CH9141_STATS` is defined at compile time */
+typedef struct ch9141_Stats_s {
+    ch9141_StatsOp_t op[CH9141_STATE_NUM]; // Indexed by the operation state, e.g. `op[CH9141_STATE_VCC_GET]`
+    uint32_t errors[CH9141_ERR_NUM]; // Failed exchanges by driver error code
+    uint32_t errorsAT[CH9141_AT_ERR_NUM]; // Error responses by device error code. Unknown codes go to `NONE` entry
+    uint32_t modeSwitches; // Number of AT/transparent mode switches
+    uint32_t resets; // Number of device resets
+    uint32_t reloads; // Number of factory restores
+    uint32_t retries; // Number of repeated device checks and connect status receptions
+} ch9141_Stats_t;
+
+/* Serial interface call traced */
+typedef enum ch9141_TraceKind_e {
+    CH9141_TRACE_TX, // `interface.transmit`
+    CH9141_TRACE_RX, // `interface.receive`
+    CH9141_TRACE_RX_RESPONSE, // `interface.receiveResponse`
+    CH9141_TRACE_RX_POLL // `interface.receivePoll`. Polls with no data are not traced
+} ch9141_TraceKind_t;
+
+/* Wire trace record header, followed by `len` payload bytes in the trace ring */
+typedef struct ch9141_TraceRecord_s {
+    uint32_t time; // [ms]. `interface.tick` time the call has returned at, `0` if not provided
+    uint16_t len; // Number of bytes transmitted or received
+    uint8_t kind; // Interface function called (see `ch9141_TraceKind_t`)
+    uint8_t ok; // `1` if the call has succeeded
+    uint8_t state; // Operation the call belongs to (see `ch9141_State_t`)
+} ch9141_TraceRecord_t;
+
+/**
+ * @brief Wire trace dump function template
+ * @param line null-terminated text line, ending with `\n`
+ */
+typedef void (*ch9141_TracePrint_fp)(char const *line);
+
 /* Platform functions pointers */
 /**
  * @brief The one of UARTx receive function templates
@@ -129,6 +243,40 @@ typedef enum ch9141_BLEStatus_e {
  */
 typedef ch9141_ErrorStatus_t (*ch9141_Receive_fp)(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
 
+/**
+ * @brief The one of UARTx receive function templates completed by AT response terminator
+ * @param handle optional pointer to the UART handle
+ * @param pDataRx pointer to the buffer where data will be saved
+ * @param size number of bytes to read
+ * @param rxLen pointer to variable to keep the number of bytes actually received
+ * @return Status of the data transfer request operation
+ * @note Should return as soon as received data is recognized by `CH9141_ResponseIsComplete`, buffer is full or timeout
+ * expires. Partial data received before timeout is a success
+ */
+typedef ch9141_ErrorStatus_t (*ch9141_ReceiveResponse_fp)(void *handle, char *pDataRx, uint16_t size,
+                                                           uint16_t *rxLen);
+
+/**
+ * @brief The one of UARTx non-blocking receive function templates
+ * @param handle optional pointer to the UART handle
+ * @param pDataRx pointer to the buffer where data will be saved
+ * @param size max number of bytes to read
+ * @param rxLen pointer to variable to keep the number of bytes actually read, `0` if nothing received yet
+ * @return Status of the data transfer request operation
+ * @note Must return immediately with the data received so far. Reception has to run in background (e.g. DMA or
+ * interrupt driven ring buffer)
+ */
+typedef ch9141_ErrorStatus_t (*ch9141_ReceivePoll_fp)(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
+
+/**
+ * @brief The one of UARTx baudrate reconfiguration function templates
+ * @param handle optional pointer to the UART handle
+ * @param baudRate new baudrate
+ * @return Status of the operation. Error if the UART does not support the baudrate
+ * @note Must not wait for the ongoing transfers: called right after the device is reset to boot with the new baudrate
+ */
+typedef ch9141_ErrorStatus_t (*ch9141_BaudSet_fp)(void *handle, uint32_t baudRate);
+
 /**
  * @brief The one of UARTx transmit function templates
  * @param handle optional pointer to the UART handle
@@ -138,6 +286,12 @@ typedef ch9141_ErrorStatus_t (*ch9141_Receive_fp)(void *handle, char *pDataRx, u
  */
 typedef ch9141_ErrorStatus_t (*ch9141_Transmit_fp)(void *handle, char const *pDataTx, uint16_t size);
 
+/**
+ * @brief Provides monotonic time
+ * @return [ms]. Current time, may wrap around
+ */
+typedef uint32_t (*ch9141_Tick_fp)(void);
+
 /**
  * @brief Provides minimum delay
  * @param ms specifies the delay time length, in milliseconds
@@ -150,18 +304,51 @@ typedef void (*ch9141_Pin_Delay_fp)(uint32_t ms);
  */
 typedef void (*ch9141_Pin_fp)(ch9141_PinState_t newState);
 
-/* Device handle */
+struct ch9141_s;
+
+/**
+ * @brief Asynchronous operation completion callback
+ * @param handle pointer to the device handle
+ * @param op completed operation. Check `handle->error` for the result
+ */
+typedef void (*ch9141_AsyncDone_fp)(struct ch9141_s *handle, ch9141_State_t op);
+
+/* Device handle. The driver keeps all its state here, so independent handles (different devices on different serial
+ * interfaces) can be used concurrently, e.g. from separate threads. Calls on the same handle must not overlap */
 typedef struct ch9141_s {
     struct {
         ch9141_Receive_fp receive; // Pointer to the platform serial interface receive function
         ch9141_Transmit_fp transmit; // Pointer to the platform serial interface transmit function
+        ch9141_ReceiveResponse_fp receiveResponse; // Optional pointer to the platform serial interface receive function
+                                                   // completed by AT response terminator. `receive` is used if `NULL`
+        ch9141_ReceivePoll_fp receivePoll; // Optional pointer to the platform serial interface non-blocking receive
+                                           // function. Required by asynchronous operations
+        ch9141_BaudSet_fp baudSet; // Optional pointer to the platform serial interface baudrate reconfiguration
+                                   // function. Required by `CH9141_BaudNegotiate`
         ch9141_Pin_Delay_fp delay; // Pointer to the platform `Delay` function
+        ch9141_Tick_fp tick; // Optional pointer to the platform time function. Required by latency statistics
         ch9141_Pin_fp pinMode; // Pointer to the platform gpio pin `AT mode` set/reset function (CH9141 PIN6)
         ch9141_Pin_fp pinReset; // Pointer to the platform gpio pin `Reset` set/reset function (CH9141 PIN16)
         ch9141_Pin_fp pinReload; // Pointer to the platform gpio pin `Reload` set/reset function (CH9141 PIN23)
         ch9141_Pin_fp pinSleep; // Pointer to the platform gpio pin `Sleep` set/reset function (CH9141 PIN24)
         void *handle; // Optional pointer to the UART handle
     } interface;
+    ch9141_AsyncDone_fp asyncDone; // Optional asynchronous operation completion callback
+    uint32_t const *baudCandidates; // Optional list of baudrates `CH9141_Init` looks for the device at, the host UART
+                                    // default one first. Requires `interface.baudSet`
+    uint8_t baudCandidatesNum; // Number of baudrates in `baudCandidates`
+    bool cacheEn; // Serve configuration getters from the values confirmed by the previous get/set (see `cache`)
+#ifdef CH9141_STATS
+    ch9141_Stats_t stats; // Kept across reinitialization
+#endif
+#ifdef CH9141_TRACE
+    struct {
+        uint8_t data[CH9141_TRACE_SIZE]; // Records, the oldest ones are overwritten
+        uint32_t head; // Offset of the oldest record
+        uint32_t used; // Number of bytes occupied by records
+        uint32_t dropped; // Number of records overwritten
+    } trace; // Kept across reinitialization
+#endif
 
     char rxBuf[50];
     char txBuf[50];
@@ -170,16 +357,143 @@ typedef struct ch9141_s {
     ch9141_State_t state; // Indicates current state of BLE IC
     ch9141_Error_t error; // Driver error codes
     ch9141_AT_Error_t errorAT; // Device error codes provided by manufacturer
+    bool session; // Indicates AT session is active (see `CH9141_SessionBegin`)
+    bool sessionAT; // Indicates device is already in AT mode within the active session
+    bool resetDefer; // Indicates setters postpone device reset until `CH9141_Commit` is called
+    bool resetPending; // Indicates device reset is required for the new settings to take effect
+    bool softwareModeForce; // Use `AT.../AT+EXIT` instead of AT mode pin
+    bool helloOff; // Indicates hello message is known to be disabled, so the boot is not waited for it
+    ch9141_IfcMode_t modeForce; // Mode used by any switch regardless of the requested one
+    uint32_t baudRate; // Host UART baudrate set through `interface.baudSet`, `0` if not set by the driver
+    struct {
+        uint16_t valid; // Bit mask of the valid entries
+        char value[11][30]; // Get response of serial, hello, names, sleep, power, mode, password, MAC and GPIO config
+    } cache; // Dropped on factory restore, reinitialization and any communication error
+    struct {
+        bool active; // Indicates operation is in progress
+        ch9141_State_t op; // Operation in progress or the last completed one
+        uint8_t step; // Current step of the operation
+        uint32_t deadline; // [ms]. Time when the current step expires
+        ch9141_Error_t error; // Error postponed until the device is switched back to transparent mode
+        uint16_t value; // Result of the completed getter
+        char response[10]; // Mode switch or connect status response
+        uint16_t responseLen;
+#ifdef CH9141_STATS
+        uint32_t start; // [ms]. Time of the first `CH9141_Process` call of the operation
+#endif
+    } async;
 } ch9141_t;
 
 /**
  * @brief Initializes/Reinitializes the target device
  * @param handle pointer to the target device handle
+ * @param factoryRestore restore factory settings after the device is found
  * @note In case of communication break between MCU and BLE IC, reinitialization is only possible if `pinReset` and
  * `pinReload` interface functions are provided. It is because UART parameters between devices do not match.
+ * @note If `baudCandidates` and `interface.baudSet` are provided, the device is looked for at every candidate
+ * baudrate instead, keeping its settings. The host UART is left at the baudrate the device has answered at
+ * @note Host UART is switched to the factory baudrate on factory restore if `interface.baudSet` is provided
  */
 void CH9141_Init(ch9141_t *handle, bool factoryRestore);
 
+/**
+ * @brief Begins AT session: device is switched to AT mode once and kept there until `CH9141_SessionEnd` is called
+ * @param handle pointer to the target device handle
+ * @note Any getters/setters can be called within the session. They skip their own AT/transparent mode switches.
+ * @note Device is switched to AT mode again on demand if any setter resets it within the session
+ * @note If `cacheEn` is set, AT mode is entered by the first command actually sent to the device within the session
+ * @note Asynchronous operations are refused within the session
+ */
+void CH9141_SessionBegin(ch9141_t *handle);
+
+/**
+ * @brief Ends AT session and switches device back to transparent mode
+ * @param handle pointer to the target device handle
+ * @note Device is switched back to transparent mode even if any error occurred within the session
+ */
+void CH9141_SessionEnd(ch9141_t *handle);
+
+/**
+ * @brief Enables or disables deferred reset mode
+ * @param handle pointer to the target device handle
+ * @param funcState enable or disable deferred reset mode
+ * @note In deferred reset mode setters do not reset the device, but only mark it as "reset pending". Call
+ * `CH9141_Commit` to apply all the new settings with a single reset.
+ */
+void CH9141_ResetDefer(ch9141_t *handle, ch9141_FuncState_t funcState);
+
+/**
+ * @brief Resets the device once if any setter has postponed its reset
+ * @param handle pointer to the target device handle
+ * @note Does nothing if no reset is pending
+ */
+void CH9141_Commit(ch9141_t *handle);
+
+/**
+ * @brief Brings the device to the desired configuration
+ * @param handle pointer to the target device handle
+ * @param config pointer to the desired device configuration
+ * @note Current parameters are read within a single AT session and only mismatched ones are written. Device is reset
+ * at most once at the end.
+ * @note Can be called within the session, which is kept open then
+ * @note Any failure stops the subsequent parameters, but the ones already written take effect: device is reset anyway
+ * and the first error is reported
+ * @note Password check state is not readable, so it is written only along with the mismatched password
+ * @note Serial interface parameters are written last. Use them with care, because they may break communication
+ * between MCU and BLE IC (see `CH9141_SerialSet`).
+ */
+void CH9141_Apply(ch9141_t *handle, ch9141_Config_t const *config);
+
+/**
+ * @brief Drops all the cached configuration values
+ * @param handle pointer to the target device handle
+ * @note Call it if the device configuration has been changed bypassing the driver
+ */
+void CH9141_CacheInvalidate(ch9141_t *handle);
+
+#ifdef CH9141_STATS
+/**
+ * @brief Gets driver statistics
+ * @param handle pointer to the target device handle
+ * @param stats pointer to the structure filled with the statistics
+ * @note Synchronous operations latency is measured only if `interface.tick` is provided. Asynchronous ones use the
+ * time passed to `CH9141_Process`
+ */
+void CH9141_StatsGet(ch9141_t const *handle, ch9141_Stats_t *stats);
+
+/**
+ * @brief Clears driver statistics
+ * @param handle pointer to the target device handle
+ */
+void CH9141_StatsReset(ch9141_t *handle);
+#endif
+
+#ifdef CH9141_TRACE
+/**
+ * @brief Prints wire trace, the oldest record first. The trace is kept
+ * @param handle pointer to the target device handle
+ * @param print function called with each text line: `<time ms> <TX|RX|RXR|RXP> <ok> <state> <hex payload>`
+ * @note The format is read by the `ch9141_replay` host tool
+ */
+void CH9141_TraceDump(ch9141_t const *handle, ch9141_TracePrint_fp print);
+
+/**
+ * @brief Clears wire trace
+ * @param handle pointer to the target device handle
+ */
+void CH9141_TraceClear(ch9141_t *handle);
+#endif
+
+/**
+ * @brief Checks if the received data ends with complete AT response: `OK\r\n`, `LINK OK\r\n` or `ERR:n\r\n`
+ * @param pData pointer to the received data
+ * @param len number of bytes received
+ * @return `true` if response is complete
+ * @note Intended for `interface.receiveResponse` implementations
+ * @note Parameter value equal to `OK` (e.g. device name) completes the response earlier than the chip finishes it
+ */
+bool CH9141_ResponseIsComplete(char const *pData, uint16_t len);
+
 /**
  * @brief Gets serial interface parameters
  * @param handle pointer to the target device handle
@@ -187,6 +501,14 @@ void CH9141_Init(ch9141_t *handle, bool factoryRestore);
  */
 char *CH9141_SerialGet(ch9141_t *handle);
 
+/**
+ * @brief Gets serial interface parameters
+ * @param handle pointer to the target device handle
+ * @param serial pointer to the structure filled with the parameters
+ * @note Check `handle.error == CH9141_ERR_NONE` after calling this function to ensure `serial` is filled
+ */
+void CH9141_SerialGetEx(ch9141_t *handle, ch9141_SerialCfg_t *serial);
+
 /**
  * @brief Sets serial interface parameters
  * @param handle pointer to the target device handle
@@ -202,6 +524,20 @@ char *CH9141_SerialGet(ch9141_t *handle);
 void CH9141_SerialSet(ch9141_t *handle, uint32_t baudRate, uint8_t dataBit, uint8_t stopBit,
                       ch9141_SerialParity_t parity, uint16_t timeout);
 
+/**
+ * @brief Switches the device and the host UART to the highest common baudrate
+ * @param handle pointer to the target device handle
+ * @param maxBaud [bit/s]. Max baudrate to try (up 1Mbit/s)
+ * @note Standard baudrates from `maxBaud` down to the current one are tried in turn, skipping the ones refused by
+ * `interface.baudSet`. Each switch is verified with `AT+UART?` at the new baudrate, the previous one is restored on
+ * failure and the next lower baudrate is tried. Other serial parameters are kept
+ * @note Does nothing if the current baudrate is not lower than `maxBaud`
+ * @note Can be called within the session, which is kept open then
+ * @note `CH9141_ERR_NO_DEVICE` means the device cannot be reached at either baudrate: reinitialize it with factory
+ * restore
+ */
+void CH9141_BaudNegotiate(ch9141_t *handle, uint32_t maxBaud);
+
 /**
  * @brief Connects to the slave with provided mac address and password
  * @param handle pointer to the target device handle
@@ -238,6 +574,14 @@ void CH9141_HelloSet(ch9141_t *handle, char const *helloSet);
  */
 char *CH9141_DeviceNameGet(ch9141_t *handle);
 
+/**
+ * @brief Gets device name
+ * @param handle pointer to the target device handle
+ * @param name pointer to the structure filled with the device name
+ * @note Check `handle.error == CH9141_ERR_NONE` after calling this function to ensure `name` is filled
+ */
+void CH9141_DeviceNameGetEx(ch9141_t *handle, ch9141_Name_t *name);
+
 /**
  * @brief Sets device name
  * @param handle pointer to the target device handle
@@ -252,6 +596,14 @@ void CH9141_DeviceNameSet(ch9141_t *handle, char const *nameSet);
  */
 char *CH9141_ChipNameGet(ch9141_t *handle);
 
+/**
+ * @brief Gets chip name
+ * @param handle pointer to the target device handle
+ * @param name pointer to the structure filled with the chip name
+ * @note Check `handle.error == CH9141_ERR_NONE` after calling this function to ensure `name` is filled
+ */
+void CH9141_ChipNameGetEx(ch9141_t *handle, ch9141_Name_t *name);
+
 /**
  * @brief Sets chip name
  * @param handle pointer to the target device handle
@@ -338,6 +690,14 @@ ch9141_BLEStatus_t CH9141_StatusGet(ch9141_t *handle);
  */
 char *CH9141_MACLocalGet(ch9141_t *handle);
 
+/**
+ * @brief Gets device BLE MAC address
+ * @param handle pointer to the target device handle
+ * @param mac pointer to the structure filled with the address
+ * @note Check `handle.error == CH9141_ERR_NONE` after calling this function to ensure `mac` is filled
+ */
+void CH9141_MACLocalGetEx(ch9141_t *handle, ch9141_MAC_t *mac);
+
 /**
  * @brief Sets device BLE MAC address
  * @param handle pointer to the target device handle
@@ -352,6 +712,14 @@ void CH9141_MACLocalSet(ch9141_t *handle, char const *mac);
  */
 char *CH9141_MACRemoteGet(ch9141_t *handle);
 
+/**
+ * @brief Gets connected device BLE MAC address
+ * @param handle pointer to the target device handle
+ * @param mac pointer to the structure filled with the address
+ * @note Check `handle.error == CH9141_ERR_NONE` after calling this function to ensure `mac` is filled
+ */
+void CH9141_MACRemoteGetEx(ch9141_t *handle, ch9141_MAC_t *mac);
+
 /**
  * @brief Gets supply voltage of the chip
  * @param handle pointer to the target device handle
@@ -410,4 +778,94 @@ uint16_t CH9141_GPIOEnGet(ch9141_t *handle);
  * @param handle pointer to the target device handle
  * @param configIO new GPIO enable config byte
  */
-void CH9141_GPIOEnSet(ch9141_t *handle, uint8_t configIO);
\ No newline at end of file
+void CH9141_GPIOEnSet(ch9141_t *handle, uint8_t configIO);
+
+/**
+ * @brief Advances asynchronous operation of the device without blocking
+ * @param handle pointer to the target device handle
+ * @param now current time [ms]
+ * @return `true` while the operation is in progress
+ * @note Call it periodically (e.g. from the main loop) after any `CH9141_xxxAsync` function. Completion is reported by
+ * `asyncDone` callback, if provided, right before `false` is returned
+ * @note Asynchronous operations require `interface.receivePoll`. AT command transmission is still blocking, but it
+ * takes a few milliseconds only
+ * @note Errors are reported on completion, after the device is switched back to transparent mode
+ * @note Synchronous functions are refused with `CH9141_ERR_BUSY` while the operation is in progress. The error is
+ * replaced by the operation result on completion
+ */
+bool CH9141_Process(ch9141_t *handle, uint32_t now);
+
+/**
+ * @brief Starts asynchronous BLE status request
+ * @param handle pointer to the target device handle
+ * @return Status of the request. Error if another operation is in progress, it goes on unaffected then, or AT session
+ * is open
+ * @note Result is available as `handle->async.value` (`ch9141_BLEStatus_t`) once completed
+ */
+ch9141_ErrorStatus_t CH9141_StatusGetAsync(ch9141_t *handle);
+
+/**
+ * @brief Starts asynchronous connected device BLE MAC address request
+ * @param handle pointer to the target device handle
+ * @return Status of the request. Error if another operation is in progress, it goes on unaffected then, or AT session
+ * is open
+ * @note Result is available as `handle->rxBuf` null-terminated string once completed
+ */
+ch9141_ErrorStatus_t CH9141_MACRemoteGetAsync(ch9141_t *handle);
+
+/**
+ * @brief Starts asynchronous supply voltage request
+ * @param handle pointer to the target device handle
+ * @return Status of the request. Error if another operation is in progress, it goes on unaffected then, or AT session
+ * is open
+ * @note Result is available as `handle->async.value` [mV] once completed
+ */
+ch9141_ErrorStatus_t CH9141_VCCGetAsync(ch9141_t *handle);
+
+/**
+ * @brief Starts asynchronous ADC value request
+ * @param handle pointer to the target device handle
+ * @return Status of the request. Error if another operation is in progress, it goes on unaffected then, or AT session
+ * is open
+ * @note Result is available as `handle->async.value` once completed
+ */
+ch9141_ErrorStatus_t CH9141_ADCGetAsync(ch9141_t *handle);
+
+/**
+ * @brief Starts asynchronous GPIO level request
+ * @param handle pointer to the target device handle
+ * @param pin pin number (1, 3, 4, 5, 6, 7)
+ * @return Status of the request. Error if another operation is in progress, it goes on unaffected then, or AT session
+ * is open
+ * @note Result is available as `handle->async.value` (`ch9141_PinState_t`) once completed
+ */
+ch9141_ErrorStatus_t CH9141_GPIOGetAsync(ch9141_t *handle, uint8_t pin);
+
+/**
+ * @brief Starts asynchronous GPIO level set
+ * @param handle pointer to the target device handle
+ * @param pin pin number (0, 2, 4, 5, 6, 7)
+ * @param pinState new GPIO pin level
+ * @return Status of the request. Error if another operation is in progress, it goes on unaffected then, or AT session
+ * is open
+ */
+ch9141_ErrorStatus_t CH9141_GPIOSetAsync(ch9141_t *handle, uint8_t pin, ch9141_PinState_t pinState);
+
+/**
+ * @brief Starts asynchronous connection to the remote BLE device
+ * @param handle pointer to the target device handle
+ * @param mac BLE slave MAC address (format xx:xx:xx:xx:xx:xx) as a null-terminated string
+ * @param password BLE slave password (6 digit) as a null-terminated string. Pass `NULL` if no password is required
+ * @return Status of the request. Error if another operation is in progress, it goes on unaffected then, or AT session
+ * is open
+ * @note Completed once the link is established
+ */
+ch9141_ErrorStatus_t CH9141_ConnectAsync(ch9141_t *handle, char const *mac, char const *password);
+
+/**
+ * @brief Starts asynchronous disconnection from the remote BLE device
+ * @param handle pointer to the target device handle
+ * @return Status of the request. Error if another operation is in progress, it goes on unaffected then, or AT session
+ * is open
+ */
+ch9141_ErrorStatus_t CH9141_DisconnectAsync(ch9141_t *handle);
@@ -0,0 +1,601 @@
+/**
+ * @file ch9141_bench.c
+ * @brief Latency benchmark of the driver API against the emulated chip on virtual time. Every case starts from the
+ * powered on chip and initialized handle, then the measured call is issued. Results are printed as JSON lines, one per
+ * case. Exit status is non-zero if any case fails or exceeds its budget.
+ *
+ * gcc -I ch9141/driver -I ch9141/emu ch9141/driver/ch9141.c ch9141/emu/ch9141_emu.c ch9141/emu/ch9141_bench.c \
+ *     -o ch9141_bench
+ */
+
+#include "ch9141_emu.h"
+
+typedef enum bench_Variant_e {
+    BENCH_VARIANT_PINS, // All optional pins are provided
+    BENCH_VARIANT_SOFTWARE, // Only UART is provided
+    BENCH_VARIANT_NUM
+} bench_Variant_t;
+
+typedef struct bench_Case_s {
+    char const *api;
+    char const *variant; // Case details
+    void (*prepare)(ch9141_t *handle); // Optional preparation, not measured
+    void (*run)(ch9141_t *handle);
+    uint32_t budget[BENCH_VARIANT_NUM]; // [ms]
+} bench_Case_t;
+
+static ch9141_Config_t const config = {.deviceName = "TAG044",
+                                       .chipName = "RTS044",
+                                       .hello = NULL,
+                                       .password = NULL,
+                                       .passwordState = CH9141_FUNC_STATE_DISABLE,
+                                       .power = CH9141_POWER_3DB,
+                                       .sleepMode = CH9141_SLEEPMODE_LOW_ENERGY,
+                                       .mode = CH9141_MODE_DEVICE,
+                                       .gpioEn = 0xF0,
+                                       .gpioInit = UINT16_MAX,
+                                       .serial = {.baudRate = 0}};
+
+static void Init(ch9141_t *handle)
+{
+    CH9141_Init(handle, false);
+}
+
+static void Init_FactoryRestore(ch9141_t *handle)
+{
+    CH9141_Init(handle, true);
+}
+
+static void Baud_Mismatch(ch9141_t *handle)
+{
+    static uint32_t const baudCandidates[] = {115200, 9600, 460800, 1000000};
+
+    handle->baudCandidates = baudCandidates;
+    handle->baudCandidatesNum = sizeof(baudCandidates) / sizeof(baudCandidates[0]);
+
+    /* Device has been left at another baudrate */
+    ch9141_emu1.flash.baudRate = 460800;
+    ch9141_emu1.activeBaud = 460800;
+    ch9141_emu1.chunksNum = 0;
+}
+
+static void Init_BaudDetect(ch9141_t *handle)
+{
+    CH9141_Init(handle, false);
+    if ((handle->error == CH9141_ERR_NONE) && (ch9141_emu1.param.hostBaud != 460800))
+        handle->error = CH9141_ERR_RESPONSE;
+}
+
+static void SerialGet(ch9141_t *handle)
+{
+    CH9141_SerialGet(handle);
+}
+
+static void SerialGetEx(ch9141_t *handle)
+{
+    ch9141_SerialCfg_t serial;
+
+    CH9141_SerialGetEx(handle, &serial);
+    if ((handle->error == CH9141_ERR_NONE) &&
+        ((serial.baudRate != ch9141_emu1.flash.baudRate) || (serial.dataBit != ch9141_emu1.flash.dataBit) ||
+         (serial.timeout != ch9141_emu1.flash.timeout)))
+        handle->error = CH9141_ERR_RESPONSE;
+}
+
+static void SerialSet(ch9141_t *handle)
+{
+    CH9141_SerialSet(handle, 115200, 8, 1, CH9141_SERIAL_PARITY_NONE, 100);
+}
+
+static void Hello_Off(ch9141_t *handle)
+{
+    CH9141_HelloSet(handle, "");
+}
+
+static void Host_Mode(ch9141_t *handle)
+{
+    CH9141_ModeSet(handle, CH9141_MODE_HOST);
+}
+
+static void Connect(ch9141_t *handle)
+{
+    CH9141_Connect(handle, "EF:49:66:A7:14:54", "654321");
+}
+
+static void Host_Connect(ch9141_t *handle)
+{
+    Host_Mode(handle);
+    Connect(handle);
+}
+
+static void Disconnect(ch9141_t *handle)
+{
+    CH9141_Disconnect(handle);
+}
+
+static void HelloGet(ch9141_t *handle)
+{
+    CH9141_HelloGet(handle);
+}
+
+static void HelloSet(ch9141_t *handle)
+{
+    CH9141_HelloSet(handle, "Hello!!!");
+}
+
+static void DeviceNameGet(ch9141_t *handle)
+{
+    CH9141_DeviceNameGet(handle);
+}
+
+static void DeviceNameGetEx(ch9141_t *handle)
+{
+    ch9141_Name_t name;
+
+    CH9141_DeviceNameGetEx(handle, &name);
+    if ((handle->error == CH9141_ERR_NONE) && (strcmp(name.str, ch9141_emu1.flash.deviceName) != 0))
+        handle->error = CH9141_ERR_RESPONSE;
+}
+
+static void DeviceNameSet(ch9141_t *handle)
+{
+    CH9141_DeviceNameSet(handle, "DeviceName");
+}
+
+static void Cache_Fill(ch9141_t *handle)
+{
+    handle->cacheEn = true;
+    CH9141_DeviceNameSet(handle, "DeviceName");
+}
+
+static void DeviceNameGet_Cached(ch9141_t *handle)
+{
+    char const *pName = CH9141_DeviceNameGet(handle);
+
+    if ((pName != NULL) && (strcmp(pName, "DeviceName") != 0))
+        handle->error = CH9141_ERR_RESPONSE;
+}
+
+static void ChipNameGet(ch9141_t *handle)
+{
+    CH9141_ChipNameGet(handle);
+}
+
+static void ChipNameSet(ch9141_t *handle)
+{
+    CH9141_ChipNameSet(handle, "ChipName");
+}
+
+static void SleepGet(ch9141_t *handle)
+{
+    CH9141_SleepGet(handle);
+}
+
+static void SleepSet(ch9141_t *handle)
+{
+    CH9141_SleepSet(handle, CH9141_SLEEPMODE_LOW_ENERGY);
+}
+
+static void PowerGet(ch9141_t *handle)
+{
+    CH9141_PowerGet(handle);
+}
+
+static void PowerSet(ch9141_t *handle)
+{
+    CH9141_PowerSet(handle, CH9141_POWER_3DB);
+}
+
+static void ModeGet(ch9141_t *handle)
+{
+    CH9141_ModeGet(handle);
+}
+
+static void ModeSet(ch9141_t *handle)
+{
+    CH9141_ModeSet(handle, CH9141_MODE_DEVICE);
+}
+
+static void PasswordGet(ch9141_t *handle)
+{
+    CH9141_PasswordGet(handle);
+}
+
+static void PasswordSet(ch9141_t *handle)
+{
+    CH9141_PasswordSet(handle, "123456", CH9141_FUNC_STATE_ENABLE);
+}
+
+static void StatusGet(ch9141_t *handle)
+{
+    CH9141_StatusGet(handle);
+}
+
+static void MACLocalGet(ch9141_t *handle)
+{
+    CH9141_MACLocalGet(handle);
+}
+
+static void MACLocalGetEx(ch9141_t *handle)
+{
+    ch9141_MAC_t mac;
+
+    CH9141_MACLocalGetEx(handle, &mac);
+    if ((handle->error == CH9141_ERR_NONE) && ((mac.addr[0] != 0xC2) || (mac.addr[5] != 0x41)))
+        handle->error = CH9141_ERR_RESPONSE;
+}
+
+static void MACLocalSet(ch9141_t *handle)
+{
+    CH9141_MACLocalSet(handle, "05:DF:39:4C:99:B4");
+}
+
+static void MACRemoteGet(ch9141_t *handle)
+{
+    CH9141_MACRemoteGet(handle);
+}
+
+static void MACRemoteGetEx(ch9141_t *handle)
+{
+    ch9141_MAC_t mac;
+
+    CH9141_MACRemoteGetEx(handle, &mac);
+    if ((handle->error == CH9141_ERR_NONE) && ((mac.addr[0] != 0xEF) || (mac.addr[5] != 0x54)))
+        handle->error = CH9141_ERR_RESPONSE;
+}
+
+static void VCCGet(ch9141_t *handle)
+{
+    CH9141_VCCGet(handle);
+}
+
+static void ADCGet(ch9141_t *handle)
+{
+    CH9141_ADCGet(handle);
+}
+
+static void GPIOGet(ch9141_t *handle)
+{
+    CH9141_GPIOGet(handle, 5);
+}
+
+static void GPIOSet(ch9141_t *handle)
+{
+    CH9141_GPIOSet(handle, 4, CH9141_PIN_STATE_SET);
+}
+
+static void BaudNegotiate(ch9141_t *handle)
+{
+    CH9141_BaudNegotiate(handle, 1000000);
+    if ((handle->error == CH9141_ERR_NONE) && (ch9141_emu1.activeBaud != 1000000))
+        handle->error = CH9141_ERR_RESPONSE;
+}
+
+static void BaudNegotiate_InSession(ch9141_t *handle)
+{
+    CH9141_SessionBegin(handle);
+    BaudNegotiate(handle);
+
+    /* Caller's session is still open */
+    if ((handle->error == CH9141_ERR_NONE) && !handle->session)
+        handle->error = CH9141_ERR_RESPONSE;
+    CH9141_SessionEnd(handle);
+}
+
+static ch9141_ErrorStatus_t BaudSet_Limited(void *handle, uint32_t baudRate)
+{
+    return baudRate <= 460800 ? CH9141_EMU_BaudSet(handle, baudRate) : CH9141_ERROR_STATUS_ERROR;
+}
+
+static void Host_Limit(ch9141_t *handle)
+{
+    handle->interface.baudSet = BaudSet_Limited;
+}
+
+static void BaudNegotiate_Limited(ch9141_t *handle)
+{
+    CH9141_BaudNegotiate(handle, 1000000);
+    if ((handle->error == CH9141_ERR_NONE) && (ch9141_emu1.activeBaud != 460800))
+        handle->error = CH9141_ERR_RESPONSE;
+}
+
+static void GPIOInitGet(ch9141_t *handle)
+{
+    CH9141_GPIOInitGet(handle);
+}
+
+static void GPIOInitSet(ch9141_t *handle)
+{
+    CH9141_GPIOInitSet(handle, 0xFF);
+}
+
+static void GPIOEnGet(ch9141_t *handle)
+{
+    CH9141_GPIOEnGet(handle);
+}
+
+static void GPIOEnSet(ch9141_t *handle)
+{
+    CH9141_GPIOEnSet(handle, 0xF0);
+}
+
+static void Apply(ch9141_t *handle)
+{
+    CH9141_Apply(handle, &config);
+}
+
+static void Apply_Failed(ch9141_t *handle)
+{
+    ch9141_Config_t failing = config;
+
+    failing.chipName = "RTS044-TOO-LONG-NAME";
+    CH9141_Apply(handle, &failing);
+
+    /* Device name written before the failure is in effect */
+    if ((handle->error == CH9141_ERR_ARGUMENT) && (ch9141_emu1.stats.resets == 1) && !handle->resetPending)
+        handle->error = CH9141_ERR_NONE;
+    else if (handle->error == CH9141_ERR_NONE)
+        handle->error = CH9141_ERR_RESPONSE;
+}
+
+static void Apply_Keep(ch9141_t *handle)
+{
+    ch9141_Config_t keep = CH9141_CONFIG_KEEP;
+
+    CH9141_Apply(handle, &keep);
+}
+
+static void Apply_InSession(ch9141_t *handle)
+{
+    CH9141_SessionBegin(handle);
+    CH9141_Apply(handle, &config);
+
+    /* Caller's session is still open */
+    if ((handle->error == CH9141_ERR_NONE) && !handle->session)
+        handle->error = CH9141_ERR_RESPONSE;
+    CH9141_SessionEnd(handle);
+}
+
+static void Apply_Cached(ch9141_t *handle)
+{
+    handle->cacheEn = true;
+    CH9141_Apply(handle, &config);
+}
+
+/**
+ * @brief Drives asynchronous operation to its completion, as the main loop would do
+ * @param handle pointer to the device handle
+ */
+static void Async_Complete(ch9141_t *handle)
+{
+    while (CH9141_Process(handle, (uint32_t) (CH9141_EMU_Micros() / 1000u)))
+        CH9141_EMU_Delay(1);
+}
+
+static void StatusGetAsync(ch9141_t *handle)
+{
+    CH9141_StatusGetAsync(handle);
+    Async_Complete(handle);
+}
+
+static void VCCGetAsync(ch9141_t *handle)
+{
+    CH9141_VCCGetAsync(handle);
+    Async_Complete(handle);
+}
+
+static void GPIOGetAsync(ch9141_t *handle)
+{
+    CH9141_GPIOGetAsync(handle, 5);
+    Async_Complete(handle);
+}
+
+static void GPIOSetAsync(ch9141_t *handle)
+{
+    CH9141_GPIOSetAsync(handle, 4, CH9141_PIN_STATE_SET);
+    Async_Complete(handle);
+}
+
+static void ConnectAsync(ch9141_t *handle)
+{
+    CH9141_ConnectAsync(handle, "EF:49:66:A7:14:54", "654321");
+    Async_Complete(handle);
+}
+
+static void DisconnectAsync(ch9141_t *handle)
+{
+    CH9141_DisconnectAsync(handle);
+    Async_Complete(handle);
+}
+
+static void StatusGetAsync_Busy(ch9141_t *handle)
+{
+    ch9141_ErrorStatus_t status;
+
+    CH9141_StatusGetAsync(handle);
+    CH9141_Process(handle, (uint32_t) (CH9141_EMU_Micros() / 1000u));
+
+    /* Refused without affecting the operation in progress */
+    status = CH9141_VCCGetAsync(handle);
+    Async_Complete(handle);
+    if ((handle->error == CH9141_ERR_NONE) &&
+        ((status != CH9141_ERROR_STATUS_ERROR) || (handle->async.op != CH9141_STATE_STATUS_GET) ||
+         (ch9141_emu1.pins[CH9141_EMU_PIN_MODE] != CH9141_PIN_STATE_SET) || ch9141_emu1.atSoftware))
+        handle->error = CH9141_ERR_RESPONSE;
+}
+
+static void MACRemoteGetAsync_SyncRefused(ch9141_t *handle)
+{
+    ch9141_Error_t refusal;
+
+    CH9141_MACRemoteGetAsync(handle);
+    CH9141_Process(handle, (uint32_t) (CH9141_EMU_Micros() / 1000u));
+
+    /* Refused without touching the UART or the result buffer */
+    CH9141_VCCGet(handle);
+    refusal = handle->error;
+    Async_Complete(handle);
+    if ((handle->error == CH9141_ERR_NONE) &&
+        ((refusal != CH9141_ERR_BUSY) || (strcmp(handle->rxBuf, "EF:49:66:A7:14:54") != 0)))
+        handle->error = CH9141_ERR_RESPONSE;
+}
+
+static void StatusGetAsync_InSession(ch9141_t *handle)
+{
+    ch9141_ErrorStatus_t status;
+
+    CH9141_SessionBegin(handle);
+    status = CH9141_StatusGetAsync(handle);
+    CH9141_SessionEnd(handle);
+    if ((handle->error == CH9141_ERR_NONE) && ((status != CH9141_ERROR_STATUS_ERROR) || handle->async.active))
+        handle->error = CH9141_ERR_RESPONSE;
+}
+
+#ifdef CH9141_STATS
+static void StatsGet(ch9141_t *handle)
+{
+    ch9141_Stats_t stats;
+
+    CH9141_StatsReset(handle);
+    CH9141_VCCGet(handle);
+    CH9141_VCCGetAsync(handle);
+    Async_Complete(handle);
+    CH9141_StatsGet(handle, &stats);
+    if ((handle->error == CH9141_ERR_NONE) &&
+        ((stats.op[CH9141_STATE_VCC_GET].count != 2) || (stats.op[CH9141_STATE_VCC_GET].min == 0) ||
+         (stats.modeSwitches != 4)))
+        handle->error = CH9141_ERR_RESPONSE;
+}
+#endif
+
+static bench_Case_t const cases[] = {
+    {"CH9141_Init", "factoryRestore=false", NULL, Init, {1000, 2000}},
+    {"CH9141_Init", "factoryRestore=true", NULL, Init_FactoryRestore, {4000, 2500}},
+    {"CH9141_Init", "baudrate mismatch", Baud_Mismatch, Init_BaudDetect, {1500, 3000}},
+    {"CH9141_SerialGet", "", NULL, SerialGet, {50, 600}},
+    {"CH9141_SerialGetEx", "", NULL, SerialGetEx, {50, 600}},
+    {"CH9141_SerialSet", "", NULL, SerialSet, {300, 1300}},
+    {"CH9141_SerialSet", "hello disabled", Hello_Off, SerialSet, {300, 1400}},
+    {"CH9141_Connect", "", Host_Mode, Connect, {200, 700}},
+    {"CH9141_Disconnect", "", NULL, Disconnect, {50, 600}},
+    {"CH9141_HelloGet", "", NULL, HelloGet, {50, 600}},
+    {"CH9141_HelloSet", "", NULL, HelloSet, {300, 1300}},
+    {"CH9141_DeviceNameGet", "", NULL, DeviceNameGet, {50, 600}},
+    {"CH9141_DeviceNameGetEx", "", NULL, DeviceNameGetEx, {50, 600}},
+    {"CH9141_DeviceNameGet", "cached", Cache_Fill, DeviceNameGet_Cached, {1, 1}},
+    {"CH9141_DeviceNameSet", "", NULL, DeviceNameSet, {300, 1300}},
+    {"CH9141_ChipNameGet", "", NULL, ChipNameGet, {50, 600}},
+    {"CH9141_ChipNameSet", "", NULL, ChipNameSet, {300, 1300}},
+    {"CH9141_SleepGet", "", NULL, SleepGet, {50, 600}},
+    {"CH9141_SleepSet", "", NULL, SleepSet, {300, 1300}},
+    {"CH9141_PowerGet", "", NULL, PowerGet, {50, 600}},
+    {"CH9141_PowerSet", "", NULL, PowerSet, {300, 1300}},
+    {"CH9141_ModeGet", "", NULL, ModeGet, {50, 600}},
+    {"CH9141_ModeSet", "", NULL, ModeSet, {300, 1300}},
+    {"CH9141_PasswordGet", "", NULL, PasswordGet, {50, 600}},
+    {"CH9141_PasswordSet", "", NULL, PasswordSet, {300, 1800}},
+    {"CH9141_StatusGet", "", NULL, StatusGet, {50, 600}},
+    {"CH9141_MACLocalGet", "", NULL, MACLocalGet, {50, 600}},
+    {"CH9141_MACLocalGetEx", "", NULL, MACLocalGetEx, {50, 600}},
+    {"CH9141_MACLocalSet", "", NULL, MACLocalSet, {300, 1300}},
+    {"CH9141_MACRemoteGet", "", NULL, MACRemoteGet, {50, 600}},
+    {"CH9141_MACRemoteGetEx", "connected", Host_Connect, MACRemoteGetEx, {50, 600}},
+    {"CH9141_VCCGet", "", NULL, VCCGet, {50, 600}},
+    {"CH9141_ADCGet", "", NULL, ADCGet, {50, 600}},
+    {"CH9141_GPIOGet", "", NULL, GPIOGet, {50, 600}},
+    {"CH9141_GPIOSet", "", NULL, GPIOSet, {50, 600}},
+    {"CH9141_GPIOInitGet", "", NULL, GPIOInitGet, {50, 600}},
+    {"CH9141_GPIOInitSet", "", NULL, GPIOInitSet, {50, 600}},
+    {"CH9141_GPIOEnGet", "", NULL, GPIOEnGet, {50, 600}},
+    {"CH9141_GPIOEnSet", "", NULL, GPIOEnSet, {50, 600}},
+    {"CH9141_Apply", "changed", NULL, Apply, {400, 1000}},
+    {"CH9141_Apply", "unchanged", Apply, Apply, {100, 700}},
+    {"CH9141_Apply", "failed midway", NULL, Apply_Failed, {400, 1000}},
+    {"CH9141_Apply", "within session", NULL, Apply_InSession, {400, 1000}},
+    {"CH9141_Apply", "all kept", NULL, Apply_Keep, {50, 600}},
+    {"CH9141_Apply", "unchanged, cached", Apply_Cached, Apply, {1, 1}},
+    {"CH9141_BaudNegotiate", "maxBaud=1000000", NULL, BaudNegotiate, {600, 2500}},
+    {"CH9141_BaudNegotiate", "within session", NULL, BaudNegotiate_InSession, {600, 2500}},
+    {"CH9141_BaudNegotiate", "host limited to 460800", Host_Limit, BaudNegotiate_Limited, {600, 2500}},
+    {"CH9141_StatusGetAsync", "", NULL, StatusGetAsync, {50, 600}},
+    {"CH9141_VCCGetAsync", "", NULL, VCCGetAsync, {50, 600}},
+    {"CH9141_GPIOGetAsync", "", NULL, GPIOGetAsync, {50, 600}},
+    {"CH9141_GPIOSetAsync", "", NULL, GPIOSetAsync, {50, 600}},
+    {"CH9141_ConnectAsync", "", Host_Mode, ConnectAsync, {200, 700}},
+    {"CH9141_DisconnectAsync", "", NULL, DisconnectAsync, {50, 600}},
+    {"CH9141_StatusGetAsync", "busy request", NULL, StatusGetAsync_Busy, {50, 600}},
+    {"CH9141_MACRemoteGetAsync", "sync request refused", Host_Connect, MACRemoteGetAsync_SyncRefused, {50, 600}},
+    {"CH9141_StatusGetAsync", "within session", NULL, StatusGetAsync_InSession, {50, 600}},
+#ifdef CH9141_STATS
+    {"CH9141_StatsGet", "sync and async getter", NULL, StatsGet, {100, 1200}},
+#endif
+};
+
+static char const *const variants[BENCH_VARIANT_NUM] = {"pins", "software"};
+
+/**
+ * @brief Powers on the emulated chip and fills the device handle interface
+ * @param handle pointer to the device handle
+ * @param variant set of interface functions provided
+ */
+static void Device_Prepare(ch9141_t *handle, bench_Variant_t variant)
+{
+    CH9141_EMU_Init(&ch9141_emu1);
+
+    memset(handle, 0, sizeof(ch9141_t));
+    handle->interface.handle = &ch9141_emu1;
+    handle->interface.receive = CH9141_EMU_Receive;
+    handle->interface.receiveResponse = CH9141_EMU_ReceiveResponse;
+    handle->interface.receivePoll = CH9141_EMU_ReceivePoll;
+    handle->interface.transmit = CH9141_EMU_Transmit;
+    handle->interface.baudSet = CH9141_EMU_BaudSet;
+    handle->interface.delay = CH9141_EMU_Delay;
+    handle->interface.tick = CH9141_EMU_Tick;
+    if (variant == BENCH_VARIANT_PINS)
+    {
+        handle->interface.pinMode = CH9141_EMU_Pin_Mode1;
+        handle->interface.pinReset = CH9141_EMU_Pin_Reset1;
+        handle->interface.pinReload = CH9141_EMU_Pin_Reload1;
+        handle->interface.pinSleep = CH9141_EMU_Pin_Sleep1;
+    }
+}
+
+int main(void)
+{
+    ch9141_t ble;
+    uint64_t start;
+    double elapsed;
+    bool pass;
+    bool passAll = true;
+
+    CH9141_EMU_ClockVirtual(true);
+
+    for (bench_Variant_t variant = 0; variant < BENCH_VARIANT_NUM; variant++)
+    {
+        for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        {
+            Device_Prepare(&ble, variant);
+            if (cases[i].run != Init && cases[i].run != Init_FactoryRestore && cases[i].run != Init_BaudDetect)
+                CH9141_Init(&ble, false);
+            if (cases[i].prepare != NULL)
+                cases[i].prepare(&ble);
+
+            /* Measure the call only */
+            memset(&ch9141_emu1.stats, 0, sizeof(ch9141_emu1.stats));
+            start = CH9141_EMU_Micros();
+            cases[i].run(&ble);
+            elapsed = (CH9141_EMU_Micros() - start) / 1000.0;
+
+            pass = (ble.error == CH9141_ERR_NONE) && (elapsed <= cases[i].budget[variant]);
+            passAll &= pass;
+            printf("{\"api\":\"%s\",\"case\":\"%s\",\"variant\":\"%s\",\"ms\":%.3f,\"budget_ms\":%lu,\"error\":%u,"
+                   "\"error_at\":%u,\"resets\":%lu,\"at_enters\":%lu,\"commands\":%lu,\"pass\":%s}\n",
+                   cases[i].api, cases[i].variant, variants[variant], elapsed,
+                   (unsigned long) cases[i].budget[variant], ble.error, ble.errorAT,
+                   (unsigned long) ch9141_emu1.stats.resets, (unsigned long) ch9141_emu1.stats.atEnters,
+                   (unsigned long) ch9141_emu1.stats.commands, pass ? "true" : "false");
+        }
+    }
+
+    return passAll ? 0 : 1;
+}
@@ -0,0 +1,843 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "ch9141_emu.h"
+#include <stdarg.h>
+#include <strings.h>
+#include <time.h>
+
+#define EMU_AT_IDLE_US 500000u // Enter AT configuration cmd is accepted when UART is free for 500mS
+#define EMU_RELOAD_US 2000000u // `Reload` pin has to be pulled down for 2 sec after device is powered on
+#define EMU_RESET_US 1000u // Time between `AT+RESET` response and chip reboot
+
+static uint64_t Clock_Now(void);
+static void Clock_WaitUntil(uint64_t t);
+static uint64_t Byte_Time(ch9141_Emu_t *emu);
+static void Boot(ch9141_Emu_t *emu, uint64_t t);
+static bool Mode_AT(ch9141_Emu_t *emu);
+static bool Input_Ignored(ch9141_Emu_t *emu, uint64_t t);
+static void Input(ch9141_Emu_t *emu, uint64_t t, char const *pData, uint16_t size);
+static void Output(ch9141_Emu_t *emu, uint64_t t, char const *pData, uint16_t size);
+static void Respond(ch9141_Emu_t *emu, uint64_t t, char const *format, ...);
+static void Command_Execute(ch9141_Emu_t *emu, uint64_t t, char *line);
+
+ch9141_Emu_t ch9141_emu1;
+
+static bool clockVirtual = false;
+static uint64_t clockVirtualNow = 0;
+
+void CH9141_EMU_Init(ch9141_Emu_t *emu)
+{
+    if (emu == NULL)
+        return;
+
+    memset(emu, 0, sizeof(ch9141_Emu_t));
+
+    /* Default timings */
+    emu->param.responseLatency = 5;
+    emu->param.bootTime = 150;
+    emu->param.connectTime = 100;
+    emu->param.rxTimeout = 200;
+    emu->param.hostBaud = 115200;
+
+    /* Default remote device */
+    emu->peer.present = true;
+    strcpy(emu->peer.mac, "EF:49:66:A7:14:54");
+    strcpy(emu->peer.password, "654321");
+
+    for (uint8_t pin = 0; pin < CH9141_EMU_PIN_NUM; pin++)
+        emu->pins[pin] = CH9141_PIN_STATE_SET;
+
+    /* Power on */
+    CH9141_EMU_FactoryRestore(emu);
+    Boot(emu, Clock_Now());
+}
+
+void CH9141_EMU_FactoryRestore(ch9141_Emu_t *emu)
+{
+    if (emu == NULL)
+        return;
+
+    memset(&emu->flash, 0, sizeof(emu->flash));
+    emu->flash.baudRate = 115200;
+    emu->flash.dataBit = 8;
+    emu->flash.stopBit = 1;
+    emu->flash.parity = 0;
+    emu->flash.timeout = 50;
+    strcpy(emu->flash.deviceName, "CH9141BLE2U");
+    strcpy(emu->flash.chipName, "CH9141");
+    strcpy(emu->flash.hello, "CH9141");
+    strcpy(emu->flash.password, "000000");
+    emu->flash.passwordEn = false;
+    emu->flash.power = CH9141_POWER_0DB;
+    emu->flash.sleepMode = CH9141_SLEEPMODE_NONE;
+    emu->flash.mode = CH9141_MODE_DEVICE;
+    strcpy(emu->flash.mac, "C2:3F:8A:11:09:41");
+    emu->flash.gpioInit = 0x00;
+    emu->flash.gpioEn = 0x00;
+}
+
+void CH9141_EMU_ClockVirtual(bool enable)
+{
+    /* Virtual time continues from the current real time, so timestamps stay monotonic */
+    if (enable && !clockVirtual)
+        clockVirtualNow = Clock_Now();
+    clockVirtual = enable;
+}
+
+uint64_t CH9141_EMU_Micros(void)
+{
+    return Clock_Now();
+}
+
+void CH9141_EMU_PeerSend(ch9141_Emu_t *emu, char const *pData, uint16_t size)
+{
+    uint64_t t = Clock_Now();
+
+    if ((emu == NULL) || (pData == NULL))
+        return;
+
+    /* Data is delivered to the host only if the link is established */
+    if (Mode_AT(emu) || !emu->connecting || (t < emu->connectAt))
+        return;
+
+    Output(emu, t, pData, size);
+}
+
+void CH9141_EMU_PeerConnect(ch9141_Emu_t *emu)
+{
+    uint64_t t = Clock_Now();
+
+    if ((emu == NULL) || !emu->peer.present || emu->connecting)
+        return;
+    if ((emu->pins[CH9141_EMU_PIN_RESET] == CH9141_PIN_STATE_RESET) || (t < emu->bootAt))
+        return;
+
+    emu->connecting = true;
+    emu->connectAt = t;
+}
+
+bool CH9141_EMU_PeerLinked(ch9141_Emu_t *emu)
+{
+    if (emu == NULL)
+        return false;
+
+    return emu->connecting && (Clock_Now() >= emu->connectAt);
+}
+
+void CH9141_EMU_PinWrite(ch9141_Emu_t *emu, ch9141_EmuPin_t pin, ch9141_PinState_t newState)
+{
+    uint64_t t = Clock_Now();
+    ch9141_PinState_t oldState;
+
+    if ((emu == NULL) || (pin >= CH9141_EMU_PIN_NUM))
+        return;
+    if ((newState != CH9141_PIN_STATE_SET) && (newState != CH9141_PIN_STATE_RESET))
+        return;
+
+    oldState = emu->pins[pin];
+    emu->pins[pin] = newState;
+    if (oldState == newState)
+        return;
+
+    switch (pin)
+    {
+    case CH9141_EMU_PIN_MODE:
+        if (newState == CH9141_PIN_STATE_RESET)
+            emu->stats.atEnters++;
+        else
+            emu->atSoftware = false;
+        break;
+
+    case CH9141_EMU_PIN_RESET:
+        if (newState == CH9141_PIN_STATE_RESET)
+        {
+            /* Chip is held in reset - everything on the way to the host is lost */
+            emu->chunksNum = 0;
+            emu->connecting = false;
+        }
+        else
+            Boot(emu, t);
+        break;
+
+    case CH9141_EMU_PIN_RELOAD:
+        if (newState == CH9141_PIN_STATE_RESET)
+            emu->reloadAt = t;
+        else if ((emu->reloadAt <= emu->bootAt) && (t >= emu->bootAt + EMU_RELOAD_US))
+        {
+            /* Pin has been held down for 2 sec since power on - restore factory settings and reboot */
+            emu->stats.reloads++;
+            CH9141_EMU_FactoryRestore(emu);
+            Boot(emu, t);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+ch9141_ErrorStatus_t CH9141_EMU_Receive(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen)
+{
+    ch9141_Emu_t *emu = handle;
+    uint64_t start = Clock_Now();
+    uint64_t deadline;
+    uint64_t t;
+    uint64_t byteTime;
+    uint16_t len = 0;
+    uint16_t n;
+
+    if (emu == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (pDataRx == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (size == 0u)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    deadline = start + (uint64_t) emu->param.rxTimeout * 1000u;
+    byteTime = Byte_Time(emu);
+
+    /* Data arrived before reception has started is lost */
+    while ((emu->chunksNum != 0) && (emu->chunks[0].readyAt < start))
+        memmove(&emu->chunks[0], &emu->chunks[1], --emu->chunksNum * sizeof(ch9141_EmuChunk_t));
+
+    /* Nothing arrives in time */
+    if ((emu->chunksNum == 0) || (emu->chunks[0].readyAt > deadline))
+    {
+        Clock_WaitUntil(deadline);
+        if (rxLen != NULL)
+            *rxLen = 0;
+        return CH9141_ERROR_STATUS_ERROR;
+    }
+
+    /* Collect back-to-back chunks until idle line or buffer is full */
+    t = emu->chunks[0].readyAt;
+    while ((emu->chunksNum != 0) && (emu->chunks[0].readyAt <= t + byteTime) && (len < size))
+    {
+        n = emu->chunks[0].len;
+        if (n > size - len)
+            n = size - len; // The rest of the chunk is lost
+        memcpy(&pDataRx[len], emu->chunks[0].data, n);
+        len += n;
+        t = (t > emu->chunks[0].readyAt ? t : emu->chunks[0].readyAt) + n * byteTime;
+        memmove(&emu->chunks[0], &emu->chunks[1], --emu->chunksNum * sizeof(ch9141_EmuChunk_t));
+    }
+
+    /* Idle line is detected one character later */
+    Clock_WaitUntil(len < size ? t + byteTime : t);
+    if (len < size)
+        pDataRx[len] = '\0';
+    if (rxLen != NULL)
+        *rxLen = len;
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+ch9141_ErrorStatus_t CH9141_EMU_ReceiveResponse(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen)
+{
+    ch9141_Emu_t *emu = handle;
+    uint64_t start = Clock_Now();
+    uint64_t deadline;
+    uint64_t t;
+    uint64_t byteTime;
+    uint16_t len = 0;
+    uint16_t n;
+
+    if (emu == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (pDataRx == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (size == 0u)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    deadline = start + (uint64_t) emu->param.rxTimeout * 1000u;
+    byteTime = Byte_Time(emu);
+
+    /* Data arrived before reception has started is lost */
+    while ((emu->chunksNum != 0) && (emu->chunks[0].readyAt < start))
+        memmove(&emu->chunks[0], &emu->chunks[1], --emu->chunksNum * sizeof(ch9141_EmuChunk_t));
+
+    /* Collect chunks until response is complete, buffer is full or timeout expires */
+    t = start;
+    while (!CH9141_ResponseIsComplete(pDataRx, len) && (len < size))
+    {
+        if ((emu->chunksNum == 0) || (emu->chunks[0].readyAt > deadline))
+        {
+            t = deadline;
+            break;
+        }
+
+        n = emu->chunks[0].len;
+        if (n > size - len)
+            n = size - len; // The rest of the chunk is lost
+        memcpy(&pDataRx[len], emu->chunks[0].data, n);
+        len += n;
+        t = (t > emu->chunks[0].readyAt ? t : emu->chunks[0].readyAt) + n * byteTime;
+        memmove(&emu->chunks[0], &emu->chunks[1], --emu->chunksNum * sizeof(ch9141_EmuChunk_t));
+    }
+
+    /* No need to wait for idle line */
+    Clock_WaitUntil(t);
+    if (len < size)
+        pDataRx[len] = '\0';
+    if (rxLen != NULL)
+        *rxLen = len;
+
+    return len != 0 ? CH9141_ERROR_STATUS_SUCCESS : CH9141_ERROR_STATUS_ERROR;
+}
+
+ch9141_ErrorStatus_t CH9141_EMU_ReceivePoll(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen)
+{
+    ch9141_Emu_t *emu = handle;
+    uint64_t now = Clock_Now();
+    uint64_t byteTime;
+    uint16_t len = 0;
+    uint16_t n;
+
+    if (emu == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (pDataRx == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (rxLen == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    byteTime = Byte_Time(emu);
+
+    /* Background reception: take the bytes completely arrived by now */
+    while ((emu->chunksNum != 0) && (len < size) && (emu->chunks[0].readyAt + byteTime <= now))
+    {
+        n = (now - emu->chunks[0].readyAt) / byteTime;
+        if (n > emu->chunks[0].len)
+            n = emu->chunks[0].len;
+        if (n > size - len)
+            n = size - len;
+        memcpy(&pDataRx[len], emu->chunks[0].data, n);
+        len += n;
+
+        /* Keep the rest of the chunk */
+        emu->chunks[0].len -= n;
+        emu->chunks[0].readyAt += n * byteTime;
+        memmove(emu->chunks[0].data, &emu->chunks[0].data[n], emu->chunks[0].len);
+        if (emu->chunks[0].len == 0)
+            memmove(&emu->chunks[0], &emu->chunks[1], --emu->chunksNum * sizeof(ch9141_EmuChunk_t));
+    }
+
+    *rxLen = len;
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+ch9141_ErrorStatus_t CH9141_EMU_Transmit(void *handle, char const *pDataTx, uint16_t size)
+{
+    ch9141_Emu_t *emu = handle;
+    uint64_t t;
+
+    if (emu == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (pDataTx == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (size == 0u)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Blocking transmission: data is processed by the chip as soon as the last byte is sent */
+    t = Clock_Now() + size * Byte_Time(emu);
+    Clock_WaitUntil(t);
+    Input(emu, t, pDataTx, size);
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+ch9141_ErrorStatus_t CH9141_EMU_BaudSet(void *handle, uint32_t baudRate)
+{
+    ch9141_Emu_t *emu = handle;
+
+    if (emu == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if ((baudRate == 0) || (baudRate > 1000000))
+        return CH9141_ERROR_STATUS_ERROR;
+
+    emu->param.hostBaud = baudRate;
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+void CH9141_EMU_Delay(uint32_t ms)
+{
+    Clock_WaitUntil(Clock_Now() + (uint64_t) ms * 1000u);
+}
+
+uint32_t CH9141_EMU_Tick(void)
+{
+    return (uint32_t) (Clock_Now() / 1000u);
+}
+
+void CH9141_EMU_Pin_Mode1(ch9141_PinState_t newState)
+{
+    CH9141_EMU_PinWrite(&ch9141_emu1, CH9141_EMU_PIN_MODE, newState);
+}
+
+void CH9141_EMU_Pin_Reset1(ch9141_PinState_t newState)
+{
+    CH9141_EMU_PinWrite(&ch9141_emu1, CH9141_EMU_PIN_RESET, newState);
+}
+
+void CH9141_EMU_Pin_Reload1(ch9141_PinState_t newState)
+{
+    CH9141_EMU_PinWrite(&ch9141_emu1, CH9141_EMU_PIN_RELOAD, newState);
+}
+
+void CH9141_EMU_Pin_Sleep1(ch9141_PinState_t newState)
+{
+    CH9141_EMU_PinWrite(&ch9141_emu1, CH9141_EMU_PIN_SLEEP, newState);
+}
+
+/**
+ * @section Private func definitions
+ */
+
+/**
+ * @brief Internal function used to get current time of the emulator clock
+ * @return Current time [us]
+ */
+static uint64_t Clock_Now(void)
+{
+    struct timespec ts;
+
+    if (clockVirtual)
+        return clockVirtualNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000u + (uint64_t) ts.tv_nsec / 1000u;
+}
+
+/**
+ * @brief Internal function used to block until the emulator clock reaches the provided time
+ * @param t target time [us]
+ */
+static void Clock_WaitUntil(uint64_t t)
+{
+    uint64_t now = Clock_Now();
+    struct timespec ts;
+
+    if (t <= now)
+        return;
+
+    if (clockVirtual)
+    {
+        clockVirtualNow = t;
+        return;
+    }
+
+    ts.tv_sec = (t - now) / 1000000u;
+    ts.tv_nsec = ((t - now) % 1000000u) * 1000u;
+    while (nanosleep(&ts, &ts) != 0)
+        ;
+}
+
+/**
+ * @brief Internal function used to get time of a single character on the serial line
+ * @param emu pointer to the emulator instance
+ * @return Character time [us]
+ */
+static uint64_t Byte_Time(ch9141_Emu_t *emu)
+{
+    uint32_t bits = 1u + emu->flash.dataBit + emu->flash.stopBit + (emu->flash.parity != 0 ? 1u : 0u);
+
+    return ((uint64_t) bits * 1000000u + emu->activeBaud - 1u) / emu->activeBaud;
+}
+
+/**
+ * @brief Internal function used to reboot the chip. Settings are loaded from flash
+ * @param emu pointer to the emulator instance
+ * @param t time of reset release [us]
+ */
+static void Boot(ch9141_Emu_t *emu, uint64_t t)
+{
+    emu->stats.resets++;
+    emu->bootAt = t + (uint64_t) emu->param.bootTime * 1000u;
+    emu->lastRxAt = emu->bootAt;
+    emu->activeBaud = emu->flash.baudRate;
+    emu->gpio = emu->flash.gpioInit;
+    emu->atSoftware = false;
+    emu->connecting = false;
+    emu->lineLen = 0;
+
+    /* Hello message */
+    if (emu->flash.hello[0] != '\0')
+        Respond(emu, emu->bootAt, "%s\r\n", emu->flash.hello);
+}
+
+/**
+ * @brief Internal function used to check if the chip is in AT mode
+ * @param emu pointer to the emulator instance
+ * @return `true` if the chip is in AT mode
+ */
+static bool Mode_AT(ch9141_Emu_t *emu)
+{
+    return (emu->pins[CH9141_EMU_PIN_MODE] == CH9141_PIN_STATE_RESET) || emu->atSoftware;
+}
+
+/**
+ * @brief Internal function used to check if the chip is able to receive data from the host
+ * @param emu pointer to the emulator instance
+ * @param t time of data reception [us]
+ * @return `true` if data is ignored by the chip
+ */
+static bool Input_Ignored(ch9141_Emu_t *emu, uint64_t t)
+{
+    if (emu->pins[CH9141_EMU_PIN_RESET] == CH9141_PIN_STATE_RESET)
+        return true;
+    if (emu->pins[CH9141_EMU_PIN_SLEEP] == CH9141_PIN_STATE_RESET)
+        return true;
+    if (t < emu->bootAt)
+        return true;
+    if (emu->param.hostBaud != emu->activeBaud)
+        return true;
+
+    return false;
+}
+
+/**
+ * @brief Internal function used to process data received by the chip from the host
+ * @param emu pointer to the emulator instance
+ * @param t time of the last byte reception [us]
+ * @param pData pointer to the data
+ * @param size number of bytes
+ */
+static void Input(ch9141_Emu_t *emu, uint64_t t, char const *pData, uint16_t size)
+{
+    uint64_t start = t - size * Byte_Time(emu);
+    uint64_t idle = start > emu->lastRxAt ? start - emu->lastRxAt : 0;
+
+    if (Input_Ignored(emu, t))
+    {
+        emu->stats.dropped += size;
+        return;
+    }
+    emu->lastRxAt = t;
+
+    if (!Mode_AT(emu))
+    {
+        /* Software AT mode enter */
+        if ((idle >= EMU_AT_IDLE_US) && (size >= 5) && (strncmp(pData, "AT...", 5) == 0))
+        {
+            emu->atSoftware = true;
+            emu->stats.atEnters++;
+            emu->lineLen = 0;
+            Respond(emu, t + (uint64_t) emu->param.responseLatency * 1000u, "OK\r\n");
+            return;
+        }
+
+        /* Transparent transmission */
+        if (emu->connecting && (t >= emu->connectAt))
+        {
+            emu->peer.rxBytes += size;
+            if (emu->peer.receive != NULL)
+                emu->peer.receive(emu, pData, size);
+        }
+        return;
+    }
+
+    /* Collect AT command lines */
+    for (uint16_t i = 0; i < size; i++)
+    {
+        if (pData[i] == '\n')
+        {
+            if ((emu->lineLen != 0) && (emu->line[emu->lineLen - 1] == '\r'))
+                emu->lineLen--;
+            emu->line[emu->lineLen] = '\0';
+            emu->lineLen = 0;
+            Command_Execute(emu, t, emu->line);
+        }
+        else if (emu->lineLen < sizeof(emu->line) - 1)
+            emu->line[emu->lineLen++] = pData[i];
+    }
+}
+
+/**
+ * @brief Internal function used to put data on its way from the chip to the host
+ * @param emu pointer to the emulator instance
+ * @param t time when the first byte reaches the host [us]
+ * @param pData pointer to the data
+ * @param size number of bytes
+ */
+static void Output(ch9141_Emu_t *emu, uint64_t t, char const *pData, uint16_t size)
+{
+    uint16_t n;
+    uint8_t i;
+
+    /* Host is not able to decode data with mismatched baudrate */
+    if (emu->param.hostBaud != emu->activeBaud)
+        return;
+
+    while (size != 0)
+    {
+        if (emu->chunksNum == CH9141_EMU_CHUNKS)
+            return; // Chip buffer overflow
+
+        n = size < CH9141_EMU_CHUNK_SIZE ? size : CH9141_EMU_CHUNK_SIZE;
+
+        /* Keep chunks sorted */
+        for (i = emu->chunksNum; (i != 0) && (emu->chunks[i - 1].readyAt > t); i--)
+            emu->chunks[i] = emu->chunks[i - 1];
+        emu->chunks[i].readyAt = t;
+        emu->chunks[i].len = n;
+        memcpy(emu->chunks[i].data, pData, n);
+        emu->chunksNum++;
+
+        t += n * Byte_Time(emu);
+        pData += n;
+        size -= n;
+    }
+}
+
+/**
+ * @brief Internal function used to send formatted response to the host
+ * @param emu pointer to the emulator instance
+ * @param t time when the response is ready [us]
+ * @param format printf-like format string
+ */
+static void Respond(ch9141_Emu_t *emu, uint64_t t, char const *format, ...)
+{
+    char response[CH9141_EMU_CHUNK_SIZE * 2];
+    va_list args;
+    int len;
+
+    va_start(args, format);
+    len = vsnprintf(response, sizeof(response), format, args);
+    va_end(args);
+    if (len <= 0)
+        return;
+    if ((size_t) len >= sizeof(response))
+        len = sizeof(response) - 1;
+
+    Output(emu, t, response, len);
+}
+
+/**
+ * @brief Internal function used to execute AT command
+ * @param emu pointer to the emulator instance
+ * @param t time of the command reception [us]
+ * @param line AT command line without trailing `\r\n`
+ */
+static void Command_Execute(ch9141_Emu_t *emu, uint64_t t, char *line)
+{
+    char *name;
+    char *args = "";
+    char *separator;
+    char op = '\0';
+    unsigned long baudRate;
+    unsigned int dataBit, stopBit, parity, timeout, value;
+    char mac[18];
+    char password[7];
+    uint8_t pin;
+
+    t += (uint64_t) emu->param.responseLatency * 1000u;
+    emu->stats.commands++;
+
+    if (strcmp(line, "AT...") == 0)
+    {
+        Respond(emu, t, "OK\r\n");
+        return;
+    }
+    if (strncmp(line, "AT+", 3) != 0)
+    {
+        Respond(emu, t, "\r\nERR:%u\r\n", CH9141_AT_ERR_CMD_SUP);
+        return;
+    }
+
+    /* Split the command to name, operation and arguments */
+    name = &line[3];
+    separator = strpbrk(name, "?=");
+    if (separator != NULL)
+    {
+        op = *separator;
+        *separator = '\0';
+        args = separator + 1;
+    }
+
+    if ((strcmp(name, "EXIT") == 0) && (op == '\0'))
+    {
+        Respond(emu, t, "OK\r\n");
+        emu->atSoftware = false;
+    }
+    else if ((strcmp(name, "RESET") == 0) && (op == '\0'))
+    {
+        /* Chip reboots right after the response */
+        Respond(emu, t, "OK\r\n");
+        Boot(emu, t + EMU_RESET_US);
+    }
+    else if ((strcmp(name, "RELOAD") == 0) && (op == '\0'))
+    {
+        emu->stats.reloads++;
+        CH9141_EMU_FactoryRestore(emu);
+        Respond(emu, t, "OK\r\n");
+    }
+    else if (strcmp(name, "UART") == 0)
+    {
+        if (op == '?')
+            Respond(emu, t, "%lu,%u,%u,%u,%u\r\nOK\r\n", (unsigned long) emu->flash.baudRate, emu->flash.dataBit,
+                    emu->flash.stopBit, emu->flash.parity, emu->flash.timeout);
+        else if ((op == '=') &&
+                 (sscanf(args, "%lu,%u,%u,%u,%u", &baudRate, &dataBit, &stopBit, &parity, &timeout) == 5) &&
+                 (baudRate != 0) && (baudRate <= 1000000) && ((dataBit == 8) || (dataBit == 9)) &&
+                 ((stopBit == 1) || (stopBit == 2)) && (parity <= 2) && (timeout != 0) && (timeout <= UINT16_MAX))
+        {
+            /* New parameters take effect after reset */
+            emu->flash.baudRate = baudRate;
+            emu->flash.dataBit = dataBit;
+            emu->flash.stopBit = stopBit;
+            emu->flash.parity = parity;
+            emu->flash.timeout = timeout;
+            Respond(emu, t, "OK\r\n");
+        }
+        else
+            Respond(emu, t, "\r\nERR:%u\r\n", CH9141_AT_ERR_PARAM);
+    }
+    else if ((strcmp(name, "PNAME") == 0) || (strcmp(name, "NAME") == 0) || (strcmp(name, "HELLO") == 0))
+    {
+        char *param = name[0] == 'P' ? emu->flash.deviceName
+                      : name[0] == 'N' ? emu->flash.chipName
+                                       : emu->flash.hello;
+        size_t paramSize = name[0] == 'P' ? sizeof(emu->flash.deviceName)
+                           : name[0] == 'N' ? sizeof(emu->flash.chipName)
+                                            : sizeof(emu->flash.hello);
+
+        if (op == '?')
+            Respond(emu, t, "%s\r\nOK\r\n", param);
+        else if ((op == '=') && (strlen(args) < paramSize))
+        {
+            strcpy(param, args);
+            Respond(emu, t, "OK\r\n");
+        }
+        else
+            Respond(emu, t, "\r\nERR:%u\r\n", CH9141_AT_ERR_PARAM);
+    }
+    else if ((strcmp(name, "TPL") == 0) || (strcmp(name, "SLEEP") == 0) || (strcmp(name, "BLEMODE") == 0))
+    {
+        uint8_t *param = name[0] == 'T' ? &emu->flash.power
+                         : name[0] == 'S' ? &emu->flash.sleepMode
+                                          : &emu->flash.mode;
+        unsigned int max = name[0] == 'T' ? CH9141_POWER_MIN20DB
+                           : name[0] == 'S' ? CH9141_SLEEPMODE_POWER_DOWN
+                                            : CH9141_MODE_DEVICE;
+
+        if (op == '?')
+            Respond(emu, t, "%u\r\nOK\r\n", *param);
+        else if ((op == '=') && (sscanf(args, "%u", &value) == 1) && (value <= max))
+        {
+            *param = value;
+            Respond(emu, t, "OK\r\n");
+        }
+        else
+            Respond(emu, t, "\r\nERR:%u\r\n", CH9141_AT_ERR_PARAM);
+    }
+    else if (strcmp(name, "PASS") == 0)
+    {
+        if (op == '?')
+            Respond(emu, t, "%s\r\nOK\r\n", emu->flash.password);
+        else if ((op == '=') && (strlen(args) == 6) && (strspn(args, "0123456789") == 6))
+        {
+            strcpy(emu->flash.password, args);
+            Respond(emu, t, "OK\r\n");
+        }
+        else
+            Respond(emu, t, "\r\nERR:%u\r\n", CH9141_AT_ERR_PARAM);
+    }
+    else if (strcmp(name, "PASEN") == 0)
+    {
+        if (op == '?')
+            Respond(emu, t, "%s\r\nOK\r\n", emu->flash.passwordEn ? "ON" : "OFF");
+        else if ((op == '=') && ((strcmp(args, "ON") == 0) || (strcmp(args, "OFF") == 0)))
+        {
+            emu->flash.passwordEn = strcmp(args, "ON") == 0;
+            Respond(emu, t, "OK\r\n");
+        }
+        else
+            Respond(emu, t, "\r\nERR:%u\r\n", CH9141_AT_ERR_PARAM);
+    }
+    else if (strcmp(name, "MAC") == 0)
+    {
+        if (op == '?')
+            Respond(emu, t, "%s\r\nOK\r\n", emu->flash.mac);
+        else if ((op == '=') && (strlen(args) == 17))
+        {
+            strcpy(emu->flash.mac, args);
+            Respond(emu, t, "OK\r\n");
+        }
+        else
+            Respond(emu, t, "\r\nERR:%u\r\n", CH9141_AT_ERR_PARAM);
+    }
+    else if ((strcmp(name, "CONN") == 0) && (op == '='))
+    {
+        if ((sscanf(args, "%17[^,],%6s", mac, password) < 1) || (strlen(mac) != 17))
+            Respond(emu, t, "\r\nERR:%u\r\n", CH9141_AT_ERR_PARAM);
+        else if (emu->flash.mode != CH9141_MODE_HOST)
+            Respond(emu, t, "\r\nERR:%u\r\n", CH9141_AT_ERR_CMD_SUP);
+        else
+        {
+            Respond(emu, t, "OK\r\n");
+
+            /* Link is established only if remote device is found */
+            if (emu->peer.present && (strcasecmp(mac, emu->peer.mac) == 0))
+            {
+                emu->connecting = true;
+                emu->connectAt = t + (uint64_t) emu->param.connectTime * 1000u;
+                Respond(emu, emu->connectAt, "LINK OK\r\n");
+            }
+        }
+    }
+    else if ((strcmp(name, "DISCONN") == 0) && (op == '\0'))
+    {
+        emu->connecting = false;
+        Respond(emu, t, "OK\r\n");
+    }
+    else if ((strcmp(name, "BLESTA") == 0) && (op == '?'))
+    {
+        if (emu->connecting && (t >= emu->connectAt))
+            Respond(emu, t, "%02u\r\nOK\r\n", CH9141_BLESTAT_CONNECTED);
+        else
+            Respond(emu, t, "%02u\r\nOK\r\n", CH9141_BLESTAT_ADV_CONNECTING);
+    }
+    else if ((strcmp(name, "CCADD") == 0) && (op == '?'))
+        Respond(emu, t, "%s\r\nOK\r\n",
+                (emu->connecting && (t >= emu->connectAt)) ? emu->peer.mac : "00:00:00:00:00:00");
+    else if ((strcmp(name, "BAT") == 0) && (op == '?'))
+        Respond(emu, t, "3300\r\nOK\r\n");
+    else if ((strcmp(name, "ADC") == 0) && (op == '?'))
+        Respond(emu, t, "2048\r\nOK\r\n");
+    else if ((strcmp(name, "INITIO") == 0) || (strcmp(name, "IOEN") == 0))
+    {
+        uint8_t *param = name[1] == 'N' ? &emu->flash.gpioInit : &emu->flash.gpioEn;
+
+        if (op == '?')
+            Respond(emu, t, "%02X\r\nOK\r\n", *param);
+        else if ((op == '=') && (sscanf(args, "%x", &value) == 1) && (value <= UINT8_MAX))
+        {
+            *param = value;
+            Respond(emu, t, "OK\r\n");
+        }
+        else
+            Respond(emu, t, "\r\nERR:%u\r\n", CH9141_AT_ERR_PARAM);
+    }
+    else if ((strncmp(name, "GPIO", 4) == 0) && isdigit((unsigned char) name[4]) && (name[5] == '\0'))
+    {
+        pin = name[4] - '0';
+        if ((op == '?') && (pin != 0) && (pin != 2) && (pin <= 7))
+        {
+            /* Pin is reconfigured to input mode */
+            emu->gpio = (emu->gpio & ~(1u << pin)) | (emu->gpioIn & (1u << pin));
+            Respond(emu, t, "%u\r\nOK\r\n", (emu->gpio >> pin) & 1u);
+        }
+        else if ((op == '=') && (pin != 1) && (pin != 3) && (pin <= 7) && ((strcmp(args, "0") == 0) ||
+                                                                            (strcmp(args, "1") == 0)))
+        {
+            emu->gpio = (emu->gpio & ~(1u << pin)) | ((args[0] - '0') << pin);
+            Respond(emu, t, "OK\r\n");
+        }
+        else
+            Respond(emu, t, "\r\nERR:%u\r\n", CH9141_AT_ERR_PARAM);
+    }
+    else
+        Respond(emu, t, "\r\nERR:%u\r\n", CH9141_AT_ERR_CMD_SUP);
+}
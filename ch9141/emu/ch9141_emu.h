@@ -0,0 +1,169 @@
+#pragma once
+
+#include "ch9141.h"
+
+/**
+ * @file ch9141_emu.h
+ * @brief Host-side (Linux) CH9141 emulator. Implements the AT command set used by the driver, mode pin semantics,
+ * settings persistence across reset and configurable response latency. Plugs into the driver through the regular
+ * interface functions, e.g.:
+ *
+ * gcc -I ch9141/driver -I ch9141/emu ch9141/driver/ch9141.c ch9141/emu/ch9141_emu.c app.c
+ */
+
+#define CH9141_EMU_CHUNK_SIZE 64 // Max length of the single message emitted by the emulator
+#define CH9141_EMU_CHUNKS 16 // Max number of messages waiting for the host to receive them
+#define CH9141_EMU_LINE_SIZE 64 // Max length of the AT command line
+
+typedef enum ch9141_EmuPin_e {
+    CH9141_EMU_PIN_MODE,
+    CH9141_EMU_PIN_RESET,
+    CH9141_EMU_PIN_RELOAD,
+    CH9141_EMU_PIN_SLEEP,
+    CH9141_EMU_PIN_NUM
+} ch9141_EmuPin_t;
+
+/* Settings kept in the chip flash */
+typedef struct ch9141_EmuFlash_s {
+    uint32_t baudRate;
+    uint8_t dataBit;
+    uint8_t stopBit;
+    uint8_t parity;
+    uint16_t timeout;
+    char deviceName[19];
+    char chipName[19];
+    char hello[30];
+    char password[7];
+    bool passwordEn;
+    uint8_t power;
+    uint8_t sleepMode;
+    uint8_t mode;
+    char mac[18];
+    uint8_t gpioInit;
+    uint8_t gpioEn;
+} ch9141_EmuFlash_t;
+
+/* Chunk of data on its way from the chip to the host */
+typedef struct ch9141_EmuChunk_s {
+    uint64_t readyAt; // [us]. Time when the first byte reaches the host
+    uint16_t len;
+    char data[CH9141_EMU_CHUNK_SIZE];
+} ch9141_EmuChunk_t;
+
+struct ch9141_Emu_s;
+
+/* Transparent mode data delivered to remote BLE device */
+typedef void (*ch9141_EmuPeerReceive_fp)(struct ch9141_Emu_s *emu, char const *pData, uint16_t size);
+
+/* Emulator instance */
+typedef struct ch9141_Emu_s {
+    struct {
+        uint32_t responseLatency; // [ms]. Delay between AT command reception and response
+        uint32_t bootTime; // [ms]. Delay between reset release and hello message
+        uint32_t connectTime; // [ms]. Delay between `AT+CONN` command and `LINK OK` message
+        uint32_t rxTimeout; // [ms]. Host receive timeout, mimics the platform one
+        uint32_t hostBaud; // Host UART baudrate. Chip ignores data if it does not match the chip baudrate
+    } param;
+
+    struct {
+        bool present; // Remote BLE device is in range
+        char mac[18]; // Remote BLE device MAC address
+        char password[7]; // Remote BLE device password
+        uint32_t rxBytes; // Number of transparent mode bytes received by remote BLE device
+        ch9141_EmuPeerReceive_fp receive; // Optional
+    } peer;
+
+    struct {
+        uint32_t commands; // Number of AT commands executed
+        uint32_t atEnters; // Number of AT mode enters (software and hardware)
+        uint32_t resets; // Number of chip reboots
+        uint32_t reloads; // Number of factory restores
+        uint32_t dropped; // Number of bytes ignored by the chip (reset, boot, sleep or baudrate mismatch)
+    } stats;
+
+    ch9141_EmuFlash_t flash; // Settings persisted across reset
+    ch9141_PinState_t pins[CH9141_EMU_PIN_NUM];
+    uint64_t bootAt; // [us]. Time when the chip is ready after reset
+    uint64_t reloadAt; // [us]. Time when `Reload` pin has been pulled down
+    uint64_t connectAt; // [us]. Time when the link to remote BLE device is established
+    uint64_t lastRxAt; // [us]. Time of the last byte received by the chip, used for `AT...` idle rule
+    uint32_t activeBaud; // Chip baudrate loaded from flash on boot
+    uint8_t gpio; // GPIO levels
+    uint8_t gpioIn; // Levels applied to GPIO from outside in input mode
+    bool atSoftware; // AT mode entered with `AT...` command
+    bool connecting; // `AT+CONN` issued
+    char line[CH9141_EMU_LINE_SIZE];
+    uint16_t lineLen;
+    ch9141_EmuChunk_t chunks[CH9141_EMU_CHUNKS]; // Sorted by `readyAt`
+    uint8_t chunksNum;
+} ch9141_Emu_t;
+
+/* Default instance used by `CH9141_EMU_Pin_x1` functions */
+extern ch9141_Emu_t ch9141_emu1;
+
+/**
+ * @brief Powers on the emulated chip with factory settings and default timings
+ * @param emu pointer to the emulator instance
+ */
+void CH9141_EMU_Init(ch9141_Emu_t *emu);
+
+/**
+ * @brief Restores factory settings of the emulated chip flash
+ * @param emu pointer to the emulator instance
+ */
+void CH9141_EMU_FactoryRestore(ch9141_Emu_t *emu);
+
+/**
+ * @brief Switches the emulator clock between real and virtual time
+ * @param enable `true` to use virtual time: delays and receive timeouts advance the clock instantly instead of
+ * sleeping, so any sequence of driver calls is measured deterministically
+ */
+void CH9141_EMU_ClockVirtual(bool enable);
+
+/**
+ * @brief Gets current time of the emulator clock
+ * @return Current time [us]
+ */
+uint64_t CH9141_EMU_Micros(void);
+
+/**
+ * @brief Sends data from remote BLE device to the host (transparent mode only)
+ * @param emu pointer to the emulator instance
+ * @param pData pointer to the data
+ * @param size number of bytes to send
+ */
+void CH9141_EMU_PeerSend(ch9141_Emu_t *emu, char const *pData, uint16_t size);
+
+/**
+ * @brief Establishes the link initiated by remote BLE device (central connects to the chip in device mode)
+ * @param emu pointer to the emulator instance
+ */
+void CH9141_EMU_PeerConnect(ch9141_Emu_t *emu);
+
+/**
+ * @brief Checks if the link to remote BLE device is established
+ * @param emu pointer to the emulator instance
+ * @return `true` if the link is established
+ */
+bool CH9141_EMU_PeerLinked(ch9141_Emu_t *emu);
+
+/**
+ * @brief Sets emulated chip pin level
+ * @param emu pointer to the emulator instance
+ * @param pin target pin
+ * @param newState new pin state
+ */
+void CH9141_EMU_PinWrite(ch9141_Emu_t *emu, ch9141_EmuPin_t pin, ch9141_PinState_t newState);
+
+/* Interface functions. `interface.handle` must point to the emulator instance */
+ch9141_ErrorStatus_t CH9141_EMU_Receive(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
+ch9141_ErrorStatus_t CH9141_EMU_ReceiveResponse(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
+ch9141_ErrorStatus_t CH9141_EMU_ReceivePoll(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
+ch9141_ErrorStatus_t CH9141_EMU_Transmit(void *handle, char const *pDataTx, uint16_t size);
+ch9141_ErrorStatus_t CH9141_EMU_BaudSet(void *handle, uint32_t baudRate);
+void CH9141_EMU_Delay(uint32_t ms);
+uint32_t CH9141_EMU_Tick(void);
+void CH9141_EMU_Pin_Mode1(ch9141_PinState_t newState);
+void CH9141_EMU_Pin_Reset1(ch9141_PinState_t newState);
+void CH9141_EMU_Pin_Reload1(ch9141_PinState_t newState);
+void CH9141_EMU_Pin_Sleep1(ch9141_PinState_t newState);
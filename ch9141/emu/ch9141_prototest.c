@@ -0,0 +1,651 @@
+/**
+ * @file ch9141_prototest.c
+ * @brief Host checks of the protocol modules. Frame decoder is fed with encoded streams split, coalesced, corrupted
+ * and oversized. Transport instances are connected by byte pipes on virtual time, the frames can be dropped per
+ * direction to reproduce the losses the chip causes. Dispatcher is fed with the stream as received from the radio.
+ * Multiplexer is looped back to its peer, the order of the sent chunks and the pool use are checked. Shaper output is
+ * measured on virtual time against the link of the known throughput. Results are printed as JSON lines, one per case.
+ * Exit status is non-zero if any case fails.
+ *
+ * gcc -I ch9141/driver -I ch9141/proto ch9141/proto/ch9141_frame.c ch9141/proto/ch9141_arq.c \
+ *     ch9141/proto/ch9141_dispatch.c ch9141/proto/ch9141_mux.c ch9141/proto/ch9141_shaper.c \
+ *     ch9141/emu/ch9141_prototest.c -o ch9141_prototest
+ */
+
+#include "ch9141_arq.h"
+#include "ch9141_dispatch.h"
+#include "ch9141_mux.h"
+#include "ch9141_shaper.h"
+
+#define LINK_PIPE_SIZE 4096
+
+typedef struct link_Pipe_s {
+    uint8_t data[LINK_PIPE_SIZE];
+    uint16_t len;
+    bool drop; // Frames handed to the pipe are lost
+} link_Pipe_t;
+
+typedef struct test_Case_s {
+    char const *module;
+    char const *name;
+    bool (*run)(void);
+} test_Case_t;
+
+static uint32_t now; // [ms]. Virtual time
+static ch9141_FrameDecoder_t decoder;
+static uint8_t decoderBuf[700];
+static uint8_t frameLast[700]; // Last message received by the decoder
+static uint16_t frameLastSize;
+static uint8_t framesNum;
+static uint8_t stream[3 * CH9141_FRAME_ENCODED_MAX(600)];
+static link_Pipe_t pipeAB, pipeBA;
+static ch9141_Arq_t arqA, arqB;
+static uint8_t deliveredLog[32]; // First byte of the messages delivered by B
+static uint8_t deliveredNum;
+static ch9141_Dispatcher_t dispatcher;
+static int32_t verbArgs[CH9141_DISPATCH_ARGS_MAX];
+static uint8_t verbCalls;
+static ch9141_Mux_t mux, muxPeer; // Frames sent by `mux` are received by `muxPeer`
+static uint8_t muxLog[64]; // Channels of the chunks in the order sent
+static uint8_t muxLogNum;
+static ch9141_Shaper_t shaper;
+static uint8_t shaperOut[128]; // First bytes sent by the shaper
+static uint32_t shaperOutLen; // Number of bytes sent by the shaper
+static uint32_t linkQueued; // Number of bytes sent and not delivered by the emulated link yet
+
+static uint32_t Tick(void)
+{
+    return now;
+}
+
+static void Frame_Received(uint8_t const *pData, uint16_t size, void *context)
+{
+    memcpy(frameLast, pData, size);
+    frameLastSize = size;
+    framesNum++;
+}
+
+static void Frame_Prepare(uint16_t bufSize)
+{
+    CH9141_FRAME_DecoderInit(&decoder, decoderBuf, bufSize, Frame_Received, NULL);
+    frameLastSize = 0;
+    framesNum = 0;
+}
+
+/* Message of `size` bytes, zeros included every `zeroEvery` bytes. 0 means no zeros */
+static void Frame_Message(uint8_t *pData, uint16_t size, uint16_t zeroEvery)
+{
+    for (uint16_t i = 0; i < size; i++)
+        pData[i] = ((zeroEvery != 0) && (i % zeroEvery == 0)) ? 0 : (uint8_t) (i % 255 + 1);
+}
+
+/* Message is encoded, fed in chunks of `chunk` bytes and received unchanged */
+static bool Frame_Pass(uint8_t const *pData, uint16_t size, uint16_t chunk)
+{
+    uint16_t len = CH9141_FRAME_Encode(pData, size, stream, sizeof(stream));
+    uint8_t before = framesNum;
+
+    if ((len == 0) || (len > CH9141_FRAME_ENCODED_MAX(size)) || (stream[len - 1] != CH9141_FRAME_DELIMITER) ||
+        (memchr(stream, CH9141_FRAME_DELIMITER, len - 1) != NULL))
+        return false;
+
+    for (uint16_t i = 0; i < len; i += chunk)
+        CH9141_FRAME_Decode(&decoder, &stream[i], (len - i < chunk) ? len - i : chunk);
+
+    return (framesNum == before + 1) && (frameLastSize == size) && (memcmp(frameLast, pData, size) == 0);
+}
+
+/* Messages with and without zeros, the empty one included, are decoded as encoded */
+static bool Frame_RoundTrip(void)
+{
+    static uint16_t const sizes[] = {0, 1, 2, 5, 100};
+    uint8_t msg[100];
+
+    Frame_Prepare(sizeof(decoderBuf));
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        Frame_Message(msg, sizes[i], 0);
+        if (!Frame_Pass(msg, sizes[i], UINT16_MAX))
+            return false;
+        Frame_Message(msg, sizes[i], 3);
+        if (!Frame_Pass(msg, sizes[i], UINT16_MAX))
+            return false;
+    }
+
+    return decoder.stats.frames == 10;
+}
+
+/* Frames split byte by byte and coalesced into a single chunk keep their boundaries */
+static bool Frame_Chunks(void)
+{
+    uint8_t msg[3][40];
+    uint16_t len = 0;
+
+    Frame_Prepare(sizeof(decoderBuf));
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        Frame_Message(msg[i], sizeof(msg[i]), i + 2);
+        msg[i][1] = i;
+        len += CH9141_FRAME_Encode(msg[i], sizeof(msg[i]), &stream[len], (uint16_t) (sizeof(stream) - len));
+    }
+
+    for (uint16_t i = 0; i < len; i++)
+        CH9141_FRAME_Decode(&decoder, &stream[i], 1);
+    if ((framesNum != 3) || (memcmp(frameLast, msg[2], sizeof(msg[2])) != 0))
+        return false;
+
+    CH9141_FRAME_Decode(&decoder, stream, len);
+
+    return (framesNum == 6) && (memcmp(frameLast, msg[2], sizeof(msg[2])) == 0);
+}
+
+/* Corrupted frame is dropped, the next one is received */
+static bool Frame_CrcError(void)
+{
+    uint8_t msg[20];
+    uint16_t len;
+
+    Frame_Prepare(sizeof(decoderBuf));
+    Frame_Message(msg, sizeof(msg), 0);
+    len = CH9141_FRAME_Encode(msg, sizeof(msg), stream, sizeof(stream));
+    stream[5] = (stream[5] == 0xFF) ? 0xFE : stream[5] + 1; // Data byte, not a COBS code
+    CH9141_FRAME_Decode(&decoder, stream, len);
+    if ((framesNum != 0) || (decoder.stats.crcErrors != 1))
+        return false;
+
+    return Frame_Pass(msg, sizeof(msg), 7);
+}
+
+/* Frame longer than the decoder buffer is dropped, the next one is received */
+static bool Frame_Overflow(void)
+{
+    uint8_t msg[40];
+    uint16_t len;
+
+    Frame_Prepare(16 + CH9141_FRAME_CRC_SIZE);
+    Frame_Message(msg, sizeof(msg), 5);
+    len = CH9141_FRAME_Encode(msg, sizeof(msg), stream, sizeof(stream));
+    CH9141_FRAME_Decode(&decoder, stream, len);
+    if ((framesNum != 0) || (decoder.stats.overflows != 1))
+        return false;
+
+    return Frame_Pass(msg, 16, 3);
+}
+
+/* Runs of non-zero bytes around the 254 bytes COBS block limit */
+static bool Frame_LongRun(void)
+{
+    static uint16_t const sizes[] = {252, 253, 254, 255, 256, 508, 600};
+    uint8_t msg[600];
+
+    Frame_Prepare(sizeof(decoderBuf));
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        Frame_Message(msg, sizes[i], 0);
+        if (!Frame_Pass(msg, sizes[i], 64))
+            return false;
+    }
+
+    /* Zero right after the full block */
+    Frame_Message(msg, 300, 0);
+    msg[254] = 0;
+
+    return Frame_Pass(msg, 300, 64) && (decoder.stats.cobsErrors == 0);
+}
+
+static ch9141_ErrorStatus_t Pipe_Put(link_Pipe_t *pipe, uint8_t const *pFrame, uint16_t size)
+{
+    if (pipe->drop)
+        return CH9141_ERROR_STATUS_SUCCESS;
+    if (pipe->len + size > sizeof(pipe->data))
+        return CH9141_ERROR_STATUS_ERROR;
+
+    memcpy(&pipe->data[pipe->len], pFrame, size);
+    pipe->len += size;
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+static ch9141_ErrorStatus_t Arq_TransmitA(uint8_t const *pFrame, uint16_t size, void *context)
+{
+    return Pipe_Put(&pipeAB, pFrame, size);
+}
+
+static ch9141_ErrorStatus_t Arq_TransmitB(uint8_t const *pFrame, uint16_t size, void *context)
+{
+    return Pipe_Put(&pipeBA, pFrame, size);
+}
+
+static void Arq_ReceivedB(uint8_t const *pData, uint16_t size, void *context)
+{
+    if ((size != 0) && (deliveredNum < sizeof(deliveredLog)))
+        deliveredLog[deliveredNum++] = pData[0];
+}
+
+/* Pipes are drained in both directions */
+static void Arq_Exchange(void)
+{
+    CH9141_ARQ_Receive(&arqB, pipeAB.data, pipeAB.len);
+    pipeAB.len = 0;
+    CH9141_ARQ_Receive(&arqA, pipeBA.data, pipeBA.len);
+    pipeBA.len = 0;
+}
+
+static void Arq_Prepare(void)
+{
+    memset(&pipeAB, 0, sizeof(pipeAB));
+    memset(&pipeBA, 0, sizeof(pipeBA));
+    memset(&arqA, 0, sizeof(arqA));
+    memset(&arqB, 0, sizeof(arqB));
+    deliveredNum = 0;
+    now = 1000;
+
+    arqA.transmit = Arq_TransmitA;
+    arqA.tick = Tick;
+    arqA.timeout = 100;
+    arqB.transmit = Arq_TransmitB;
+    arqB.received = Arq_ReceivedB;
+    arqB.tick = Tick;
+    arqB.timeout = 100;
+    CH9141_ARQ_Init(&arqA);
+    CH9141_ARQ_Init(&arqB);
+    CH9141_ARQ_Resume(&arqA);
+    CH9141_ARQ_Resume(&arqB);
+}
+
+/* Acknowledgments of the first messages after the restart are lost, the reset is repeated with them on timeout */
+static bool Arq_LostAckAfterReset(void)
+{
+    uint8_t msg;
+
+    Arq_Prepare();
+    pipeBA.drop = true;
+    for (msg = 0; msg < 3; msg++)
+        CH9141_ARQ_Send(&arqA, &msg, sizeof(msg));
+    Arq_Exchange();
+
+    now += arqA.timeout;
+    CH9141_ARQ_Process(&arqA);
+    pipeBA.drop = false;
+    Arq_Exchange();
+    CH9141_ARQ_Process(&arqB);
+    Arq_Exchange();
+
+    return (deliveredNum == 3) && (deliveredLog[0] == 0) && (deliveredLog[1] == 1) && (deliveredLog[2] == 2) &&
+           (arqB.stats.duplicates == 3) && (CH9141_ARQ_InFlight(&arqA) == 0);
+}
+
+/* Restarted sender of the new epoch rewinds the receiver */
+static bool Arq_RestartedSender(void)
+{
+    uint8_t msg;
+
+    Arq_Prepare();
+    for (msg = 0; msg < 5; msg++)
+        CH9141_ARQ_Send(&arqA, &msg, sizeof(msg));
+    Arq_Exchange();
+    Arq_Exchange();
+
+    arqA.epoch++;
+    CH9141_ARQ_Init(&arqA);
+    CH9141_ARQ_Resume(&arqA);
+    msg = 0x10;
+    CH9141_ARQ_Send(&arqA, &msg, sizeof(msg));
+    Arq_Exchange();
+    Arq_Exchange();
+
+    return (deliveredNum == 6) && (deliveredLog[5] == 0x10) && (CH9141_ARQ_InFlight(&arqA) == 0);
+}
+
+static void Verb_Handler(int32_t const *args, uint8_t argc, void *context)
+{
+    memcpy(verbArgs, args, argc * sizeof(args[0]));
+    verbCalls++;
+}
+
+static ch9141_Verb_t const verbs[] = {
+    {"SPED", Verb_Handler, "u"},
+    {"MOVE", Verb_Handler, "i"},
+};
+
+static void Dispatch_Prepare(void)
+{
+    memset(&dispatcher, 0, sizeof(dispatcher));
+    memset(verbArgs, 0, sizeof(verbArgs));
+    verbCalls = 0;
+
+    dispatcher.verbs = verbs;
+    dispatcher.verbNum = sizeof(verbs) / sizeof(verbs[0]);
+    CH9141_DISPATCH_Init(&dispatcher);
+}
+
+static void Dispatch_Feed(char const *stream)
+{
+    CH9141_DISPATCH_Feed(&dispatcher, stream, (uint16_t) strlen(stream));
+}
+
+/* Arguments out of range are dropped, the limits themselves pass */
+static bool Dispatch_ArgumentRange(void)
+{
+    Dispatch_Prepare();
+    Dispatch_Feed("SPED 99999999999;SPED 4294967295;SPED 2147483648;MOVE 2147483648;MOVE -2147483649;");
+    if ((verbCalls != 0) || (dispatcher.stats.argErrors != 5))
+        return false;
+
+    Dispatch_Feed("SPED 2147483647;");
+    if ((verbCalls != 1) || (verbArgs[0] != INT32_MAX))
+        return false;
+    Dispatch_Feed("MOVE -2147483648;");
+
+    return (verbCalls == 2) && (verbArgs[0] == INT32_MIN);
+}
+
+/* Unknown argument type is refused by the init */
+static bool Dispatch_UnknownSchema(void)
+{
+    static ch9141_Verb_t const bad[] = {{"SPED", Verb_Handler, "uf"}};
+
+    memset(&dispatcher, 0, sizeof(dispatcher));
+    dispatcher.verbs = bad;
+    dispatcher.verbNum = 1;
+
+    return CH9141_DISPATCH_Init(&dispatcher) == CH9141_ERROR_STATUS_ERROR;
+}
+
+static ch9141_ErrorStatus_t Mux_Transmit(uint8_t const *pFrame, uint16_t size, void *context)
+{
+    CH9141_MUX_Receive(&muxPeer, pFrame, size);
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+static void Mux_Received(uint8_t channel, uint8_t const *pData, uint16_t size, bool last, void *context)
+{
+    if (muxLogNum < sizeof(muxLog))
+        muxLog[muxLogNum++] = channel;
+}
+
+/* Channel settings of `mux` are made by the case before CH9141_MUX_Init() */
+static void Mux_Prepare(void)
+{
+    memset(&mux, 0, sizeof(mux));
+    memset(&muxPeer, 0, sizeof(muxPeer));
+    mux.transmit = Mux_Transmit;
+    muxPeer.transmit = Mux_Transmit;
+    for (uint8_t i = 0; i < CH9141_MUX_CHANNEL_NUM; i++)
+        muxPeer.channel[i].received = Mux_Received;
+    CH9141_MUX_Init(&muxPeer);
+    muxLogNum = 0;
+}
+
+/* Completes the oldest frame in flight and schedules the next one */
+static void Mux_Step(void)
+{
+    CH9141_MUX_TxDone(&mux);
+    CH9141_MUX_Process(&mux);
+}
+
+/* Urgent message queued behind the bulk transfer is sent with the next free slot */
+static bool Mux_StrictPriority(void)
+{
+    static uint8_t const expected[] = {1, 0, 1, 1, 1, 1, 1, 1, 1};
+    uint8_t bulk[4 * CH9141_MUX_CHUNK_MAX] = {0};
+    uint8_t urgent = 0x55;
+
+    Mux_Prepare();
+    mux.channel[0].priority = 0;
+    mux.channel[1].priority = 1;
+    CH9141_MUX_Init(&mux);
+
+    CH9141_MUX_Write(&mux, 1, bulk, sizeof(bulk));
+    CH9141_MUX_Write(&mux, 1, bulk, sizeof(bulk));
+    CH9141_MUX_Process(&mux);
+    if (CH9141_MUX_Write(&mux, 0, &urgent, sizeof(urgent)) != CH9141_ERROR_STATUS_SUCCESS)
+        return false;
+    while (CH9141_MUX_Queued(&mux, 1) != 0)
+        Mux_Step();
+
+    return (muxLogNum == sizeof(expected)) && (memcmp(muxLog, expected, sizeof(expected)) == 0) &&
+           (muxPeer.channel[0].stats.rxBytes == sizeof(urgent)) &&
+           (muxPeer.channel[1].stats.rxBytes == 2 * sizeof(bulk));
+}
+
+/* Channels of the same priority share the link in proportion to their weights */
+static bool Mux_WeightedShares(void)
+{
+    uint8_t msg = 0;
+    uint8_t shares[2] = {0};
+
+    Mux_Prepare();
+    mux.channel[0].weight = 3;
+    mux.channel[1].weight = 1;
+    CH9141_MUX_Init(&mux);
+
+    for (uint8_t i = 0; i < CH9141_MUX_BLOCK_NUM / 2; i++)
+    {
+        CH9141_MUX_Write(&mux, 0, &msg, sizeof(msg));
+        CH9141_MUX_Write(&mux, 1, &msg, sizeof(msg));
+    }
+    CH9141_MUX_Process(&mux);
+    while (muxLogNum < 8)
+        Mux_Step();
+
+    /* Two full rounds while both channels are backlogged */
+    for (uint8_t i = 0; i < 8; i++)
+        shares[muxLog[i]]++;
+
+    return (shares[0] == 6) && (shares[1] == 2);
+}
+
+/* Message exceeding the channel quota or the free pool is refused as a whole */
+static bool Mux_Refusal(void)
+{
+    uint8_t msg[3 * CH9141_MUX_CHUNK_MAX] = {0};
+
+    Mux_Prepare();
+    mux.channel[0].quota = 2;
+    CH9141_MUX_Init(&mux);
+
+    if ((CH9141_MUX_Write(&mux, 0, msg, sizeof(msg)) != CH9141_ERROR_STATUS_ERROR) ||
+        (CH9141_MUX_Queued(&mux, 0) != 0) || (mux.freeNum != CH9141_MUX_BLOCK_NUM))
+        return false;
+    if ((CH9141_MUX_Write(&mux, 0, msg, 2 * CH9141_MUX_CHUNK_MAX) != CH9141_ERROR_STATUS_SUCCESS) ||
+        (CH9141_MUX_Write(&mux, 0, msg, 1) != CH9141_ERROR_STATUS_ERROR))
+        return false;
+
+    /* Channel without quota takes the rest of the pool */
+    for (uint8_t i = 0; i < CH9141_MUX_BLOCK_NUM - 2; i++)
+        if (CH9141_MUX_Write(&mux, 1, msg, 1) != CH9141_ERROR_STATUS_SUCCESS)
+            return false;
+    if (CH9141_MUX_Write(&mux, 1, msg, 1) != CH9141_ERROR_STATUS_ERROR)
+        return false;
+
+    return (mux.channel[0].stats.refused == 2) && (mux.channel[1].stats.refused == 1) &&
+           (CH9141_MUX_Queued(&mux, 0) == 2) && (CH9141_MUX_Queued(&mux, 1) == CH9141_MUX_BLOCK_NUM - 2);
+}
+
+/* Blocks handed to the transmit function stay taken until done */
+static bool Mux_PoolRelease(void)
+{
+    uint8_t msg[CH9141_MUX_BLOCK_NUM * CH9141_MUX_CHUNK_MAX] = {0};
+
+    Mux_Prepare();
+    mux.inFlightMax = 2;
+    CH9141_MUX_Init(&mux);
+
+    CH9141_MUX_Write(&mux, 0, msg, sizeof(msg));
+    CH9141_MUX_Process(&mux);
+    CH9141_MUX_Process(&mux);
+    if ((mux.stats.frames != 2) || (mux.freeNum != 0) ||
+        (CH9141_MUX_Write(&mux, 1, msg, 1) == CH9141_ERROR_STATUS_SUCCESS))
+        return false;
+
+    while (CH9141_MUX_Queued(&mux, 0) != 0)
+    {
+        Mux_Step();
+        if (mux.sentNum > 2)
+            return false;
+    }
+    if (mux.freeNum != CH9141_MUX_BLOCK_NUM - 2)
+        return false;
+    Mux_Step();
+    Mux_Step();
+
+    return (mux.freeNum == CH9141_MUX_BLOCK_NUM) && (mux.sentNum == 0) && (muxLogNum == CH9141_MUX_BLOCK_NUM) &&
+           (CH9141_MUX_Write(&mux, 0, msg, sizeof(msg)) == CH9141_ERROR_STATUS_SUCCESS);
+}
+
+static ch9141_ErrorStatus_t Shaper_Transmit(uint8_t const *pData, uint16_t size, void *context)
+{
+    for (uint16_t i = 0; i < size; i++)
+        if (shaperOutLen + i < sizeof(shaperOut))
+            shaperOut[shaperOutLen + i] = pData[i];
+    shaperOutLen += size;
+    linkQueued += size;
+    CH9141_SHAPER_TxDone(&shaper); // Port queue takes the chunk at once
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+/* Settings of `shaper` are made by the case before CH9141_SHAPER_Init() */
+static void Shaper_Prepare(void)
+{
+    memset(&shaper, 0, sizeof(shaper));
+    shaper.transmit = Shaper_Transmit;
+    shaper.tick = Tick;
+    shaperOutLen = 0;
+    linkQueued = 0;
+}
+
+/* Small writes leave as full chunks, the rest waits for the deadline */
+static bool Shaper_Coalescing(void)
+{
+    uint8_t msg[6];
+    uint8_t expected[42];
+
+    Shaper_Prepare();
+    shaper.deadline = 50;
+    shaper.inFlightMax = CH9141_SHAPER_CHUNK_NUM;
+    CH9141_SHAPER_Init(&shaper);
+
+    for (uint8_t i = 0; i < 7; i++)
+    {
+        memset(msg, i, sizeof(msg));
+        memset(&expected[i * sizeof(msg)], i, sizeof(msg));
+        CH9141_SHAPER_Write(&shaper, msg, sizeof(msg));
+    }
+    CH9141_SHAPER_Process(&shaper);
+
+    return (shaper.stats.chunks == 2) && (shaperOutLen == 2 * shaper.chunkSize) &&
+           (memcmp(shaperOut, expected, shaperOutLen) == 0) && (shaper.openLen == sizeof(expected) - shaperOutLen);
+}
+
+/* Partial chunk is sent once its oldest byte waited for the deadline */
+static bool Shaper_DeadlineFlush(void)
+{
+    uint8_t msg[5] = {1, 2, 3, 4, 5};
+
+    Shaper_Prepare();
+    shaper.deadline = 50;
+    CH9141_SHAPER_Init(&shaper);
+
+    CH9141_SHAPER_Write(&shaper, msg, 2);
+    now += 30;
+    CH9141_SHAPER_Write(&shaper, &msg[2], 3);
+    now += shaper.deadline - 30 - 1;
+    CH9141_SHAPER_Process(&shaper);
+    if (shaperOutLen != 0)
+        return false;
+    now += 1;
+    CH9141_SHAPER_Process(&shaper);
+
+    return (shaper.stats.deadlineFlushes == 1) && (shaperOutLen == sizeof(msg)) &&
+           (memcmp(shaperOut, msg, sizeof(msg)) == 0);
+}
+
+/* Constant backlog is sent at the configured rate after the initial burst */
+static bool Shaper_Pacing(void)
+{
+    uint8_t msg[20] = {0};
+
+    Shaper_Prepare();
+    shaper.deadline = 1000;
+    shaper.rate = 2000;
+    CH9141_SHAPER_Init(&shaper);
+
+    for (uint16_t t = 0; t < 1000; t++)
+    {
+        CH9141_SHAPER_Write(&shaper, msg, sizeof(msg));
+        CH9141_SHAPER_Process(&shaper);
+        now++;
+    }
+
+    /* Burst and the tokens earned within the second, the last chunk may wait for the next tokens */
+    return (shaperOutLen <= shaper.burst + shaper.rate) &&
+           (shaperOutLen + 2 * shaper.chunkSize > shaper.burst + shaper.rate) && (shaper.stats.throttled != 0);
+}
+
+/* Output follows the throughput measured from the delivery reports and keeps the link queue short */
+static bool Shaper_MeasuredRate(void)
+{
+    uint32_t const linkRate = 1000; // [B/s]
+    uint8_t msg[20] = {0};
+    uint32_t rate;
+
+    Shaper_Prepare();
+    shaper.deadline = 20;
+    CH9141_SHAPER_Init(&shaper);
+
+    for (uint16_t t = 0; t < 5000; t++)
+    {
+        if (t % 10 == 0)
+            CH9141_SHAPER_Write(&shaper, msg, sizeof(msg)); // Offered load is twice the link rate
+        CH9141_SHAPER_Process(&shaper);
+        now++;
+        if (linkQueued != 0)
+        {
+            linkQueued -= linkRate / 1000;
+            CH9141_SHAPER_Delivered(&shaper, linkRate / 1000);
+        }
+    }
+    rate = CH9141_SHAPER_Rate(&shaper);
+
+    return (shaper.measure.estimate >= linkRate * 9 / 10) && (shaper.measure.estimate <= linkRate * 11 / 10) &&
+           (rate != 0) && (linkQueued <= (uint32_t) shaper.burst + shaper.chunkSize);
+}
+
+static test_Case_t const cases[] = {
+    {"frame", "round trip", Frame_RoundTrip},
+    {"frame", "split and coalesced chunks", Frame_Chunks},
+    {"frame", "crc error", Frame_CrcError},
+    {"frame", "overflow", Frame_Overflow},
+    {"frame", "254 bytes run", Frame_LongRun},
+    {"arq", "lost ack after reset", Arq_LostAckAfterReset},
+    {"arq", "restarted sender", Arq_RestartedSender},
+    {"dispatch", "argument range", Dispatch_ArgumentRange},
+    {"dispatch", "unknown schema", Dispatch_UnknownSchema},
+    {"mux", "strict priority", Mux_StrictPriority},
+    {"mux", "weighted shares", Mux_WeightedShares},
+    {"mux", "quota and pool refusal", Mux_Refusal},
+    {"mux", "pool release on tx done", Mux_PoolRelease},
+    {"shaper", "coalescing", Shaper_Coalescing},
+    {"shaper", "deadline flush", Shaper_DeadlineFlush},
+    {"shaper", "token bucket pacing", Shaper_Pacing},
+    {"shaper", "measured rate", Shaper_MeasuredRate},
+};
+
+int main(void)
+{
+    bool pass;
+    bool passAll = true;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        pass = cases[i].run();
+        passAll &= pass;
+        printf("{\"module\":\"%s\",\"case\":\"%s\",\"pass\":%s}\n", cases[i].module, cases[i].name,
+               pass ? "true" : "false");
+    }
+
+    return passAll ? 0 : 1;
+}
@@ -0,0 +1,274 @@
+/**
+ * @file ch9141_ptyd.c
+ * @brief Virtual CH9141 on a pseudo terminal. The emulated chip sits on the master side, the host opens the slave side
+ * as a regular serial port (e.g. with the Linux interface port), so the driver is exercised through the real serial
+ * stack. Host baudrate is taken from the slave termios: data is lost on mismatch as on the real line. Remote BLE device
+ * can be linked to echo transparent data back or sink it, optionally at the limited link rate.
+ *
+ * gcc -I ch9141/driver -I ch9141/emu ch9141/driver/ch9141.c ch9141/emu/ch9141_emu.c ch9141/emu/ch9141_ptyd.c \
+ *     -o ch9141_ptyd
+ *
+ * ch9141_ptyd [-l link] [-p none|echo|sink] [-r bytes/s] [-L latency ms] [-B boot ms]
+ */
+
+#define _GNU_SOURCE
+
+#include "ch9141_emu.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define PTYD_ECHO_SIZE 4096 // Data received by remote BLE device and waiting to be sent back
+#define PTYD_BURST_MIN 64 // [bytes]. Min link rate bucket, keeps short messages in one piece
+
+typedef enum ptyd_Peer_e {
+    PTYD_PEER_NONE, // Link is not established
+    PTYD_PEER_ECHO, // Remote BLE device sends received data back
+    PTYD_PEER_SINK // Remote BLE device discards received data
+} ptyd_Peer_t;
+
+static void Peer_Receive(ch9141_Emu_t *emu, char const *pData, uint16_t size);
+static uint32_t Host_Baud(int fd);
+static bool Link_Transparent(ch9141_Emu_t *emu);
+static void Signal_Handler(int signal);
+
+static volatile sig_atomic_t running = 1;
+static char echo[PTYD_ECHO_SIZE];
+static uint16_t echoLen;
+static uint32_t echoDropped;
+
+int main(int argc, char *argv[])
+{
+    ptyd_Peer_t peer = PTYD_PEER_NONE;
+    char const *link = NULL;
+    uint32_t rate = 0; // [bytes/s]. 0 - unlimited
+    uint32_t burst;
+    double tokens = 0;
+    uint64_t refillAt;
+    uint64_t now;
+    char buf[CH9141_EMU_CHUNK_SIZE];
+    uint16_t len;
+    ssize_t n;
+    int master;
+    int slave;
+    int opt;
+
+    CH9141_EMU_Init(&ch9141_emu1);
+
+    while ((opt = getopt(argc, argv, "l:p:r:L:B:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'l':
+            link = optarg;
+            break;
+
+        case 'p':
+            if (strcmp(optarg, "echo") == 0)
+                peer = PTYD_PEER_ECHO;
+            else if (strcmp(optarg, "sink") == 0)
+                peer = PTYD_PEER_SINK;
+            else
+                peer = PTYD_PEER_NONE;
+            break;
+
+        case 'r':
+            rate = strtoul(optarg, NULL, 10);
+            break;
+
+        case 'L':
+            ch9141_emu1.param.responseLatency = strtoul(optarg, NULL, 10);
+            break;
+
+        case 'B':
+            ch9141_emu1.param.bootTime = strtoul(optarg, NULL, 10);
+            break;
+
+        default:
+            fprintf(stderr, "usage: %s [-l link] [-p none|echo|sink] [-r bytes/s] [-L latency ms] [-B boot ms]\n",
+                    argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    burst = (rate / 10u > PTYD_BURST_MIN) ? rate / 10u : PTYD_BURST_MIN;
+    if (peer == PTYD_PEER_ECHO)
+        ch9141_emu1.peer.receive = Peer_Receive;
+
+    /* Pseudo terminal in raw mode, the slave is kept open so the host can reopen it */
+    master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if ((master < 0) || (grantpt(master) != 0) || (unlockpt(master) != 0))
+    {
+        perror("posix_openpt");
+        return EXIT_FAILURE;
+    }
+    slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+    if (slave < 0)
+    {
+        perror("open");
+        return EXIT_FAILURE;
+    }
+    struct termios options;
+    tcgetattr(slave, &options);
+    cfmakeraw(&options);
+    tcsetattr(slave, TCSANOW, &options);
+
+    if ((link != NULL) && (unlink(link), symlink(ptsname(master), link) != 0))
+    {
+        perror("symlink");
+        return EXIT_FAILURE;
+    }
+    printf("%s\n", ptsname(master));
+    fflush(stdout);
+
+    signal(SIGINT, Signal_Handler);
+    signal(SIGTERM, Signal_Handler);
+    refillAt = CH9141_EMU_Micros();
+
+    while (running)
+    {
+        struct pollfd pfd = {.fd = master, .events = POLLIN};
+        poll(&pfd, 1, 1);
+        now = CH9141_EMU_Micros();
+        ch9141_emu1.param.hostBaud = Host_Baud(slave);
+
+        /* Remote BLE device connects as soon as the chip is ready */
+        if ((peer != PTYD_PEER_NONE) && (ch9141_emu1.flash.mode == CH9141_MODE_DEVICE))
+            CH9141_EMU_PeerConnect(&ch9141_emu1);
+
+        /* Link rate limits transparent data only */
+        tokens += (double) (now - refillAt) * rate / 1000000.0;
+        if (tokens > burst)
+            tokens = burst;
+        refillAt = now;
+        len = sizeof(buf);
+        if ((rate != 0) && Link_Transparent(&ch9141_emu1))
+            len = tokens < len ? (uint16_t) tokens : len;
+
+        /* Host -> chip */
+        if ((pfd.revents & POLLIN) && (len != 0))
+        {
+            n = read(master, buf, len);
+            if (n > 0)
+            {
+                if ((rate != 0) && Link_Transparent(&ch9141_emu1))
+                    tokens -= n;
+                CH9141_EMU_Transmit(&ch9141_emu1, buf, n);
+            }
+        }
+
+        /* Remote BLE device -> chip */
+        while ((echoLen != 0) && (ch9141_emu1.chunksNum < CH9141_EMU_CHUNKS) && Link_Transparent(&ch9141_emu1))
+        {
+            len = echoLen < CH9141_EMU_CHUNK_SIZE ? echoLen : CH9141_EMU_CHUNK_SIZE;
+            CH9141_EMU_PeerSend(&ch9141_emu1, echo, len);
+            memmove(echo, &echo[len], echoLen - len);
+            echoLen -= len;
+        }
+
+        /* Chip -> host, paced by the serial line */
+        if ((CH9141_EMU_ReceivePoll(&ch9141_emu1, buf, sizeof(buf), &len) == CH9141_ERROR_STATUS_SUCCESS) &&
+            (len != 0))
+        {
+            if (write(master, buf, len) < 0)
+                break;
+        }
+    }
+
+    if (link != NULL)
+        unlink(link);
+    fprintf(stderr,
+            "{\"commands\":%lu,\"at_enters\":%lu,\"resets\":%lu,\"reloads\":%lu,\"dropped\":%lu,\"peer_rx_bytes\":%lu,"
+            "\"echo_dropped\":%lu}\n",
+            (unsigned long) ch9141_emu1.stats.commands, (unsigned long) ch9141_emu1.stats.atEnters,
+            (unsigned long) ch9141_emu1.stats.resets, (unsigned long) ch9141_emu1.stats.reloads,
+            (unsigned long) ch9141_emu1.stats.dropped, (unsigned long) ch9141_emu1.peer.rxBytes,
+            (unsigned long) echoDropped);
+    close(slave);
+    close(master);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Remote BLE device receive callback: keeps the data to be sent back
+ * @param emu pointer to the emulator instance
+ * @param pData pointer to the data
+ * @param size number of bytes
+ */
+static void Peer_Receive(ch9141_Emu_t *emu, char const *pData, uint16_t size)
+{
+    uint16_t n = (PTYD_ECHO_SIZE - echoLen) < size ? (PTYD_ECHO_SIZE - echoLen) : size;
+
+    (void) emu;
+
+    memcpy(&echo[echoLen], pData, n);
+    echoLen += n;
+    echoDropped += size - n;
+}
+
+/**
+ * @brief Gets baudrate the host has configured on the slave side
+ * @param fd pseudo terminal descriptor
+ * @return Baudrate, 0 if unknown
+ */
+static uint32_t Host_Baud(int fd)
+{
+    struct termios options;
+
+    if (tcgetattr(fd, &options) != 0)
+        return 0;
+
+    switch (cfgetospeed(&options))
+    {
+    case B1200:
+        return 1200;
+    case B2400:
+        return 2400;
+    case B4800:
+        return 4800;
+    case B9600:
+        return 9600;
+    case B19200:
+        return 19200;
+    case B38400:
+        return 38400;
+    case B57600:
+        return 57600;
+    case B115200:
+        return 115200;
+    case B230400:
+        return 230400;
+    case B460800:
+        return 460800;
+    case B921600:
+        return 921600;
+    case B1000000:
+        return 1000000;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Checks if the host data goes to remote BLE device
+ * @param emu pointer to the emulator instance
+ * @return `true` if the chip is in transparent mode and the link is established
+ */
+static bool Link_Transparent(ch9141_Emu_t *emu)
+{
+    return !emu->atSoftware && (emu->pins[CH9141_EMU_PIN_MODE] == CH9141_PIN_STATE_SET) &&
+           CH9141_EMU_PeerLinked(emu);
+}
+
+/**
+ * @brief Stops the daemon on SIGINT/SIGTERM
+ * @param signal signal number
+ */
+static void Signal_Handler(int signal)
+{
+    (void) signal;
+    running = 0;
+}
@@ -0,0 +1,352 @@
+/**
+ * @file ch9141_replay.c
+ * @brief Replays the wire trace captured by the driver (`CH9141_TRACE`, `CH9141_TraceDump`) into the driver through
+ * the interface functions on virtual time. Transmitted data is compared with the trace, received data and call results
+ * are taken from it, and the time is advanced to the moments the calls have returned at on the board. So the captured
+ * exchange is reproduced deterministically and can be profiled or debugged on the host. The driver calls to replay are
+ * listed as steps, they have to match the ones made on the board.
+ *
+ * gcc -I ch9141/driver ch9141/driver/ch9141.c ch9141/emu/ch9141_replay.c -o ch9141_replay
+ *
+ * ch9141_replay [-p] [-f trace] [step...]
+ *   -p      all optional pins are provided, as on the board the trace is captured at
+ *   -f      trace file, stdin by default
+ *   step    init, restore, serial, hello, name, chipname, sleep, power, mode, password, status, mac, remote, vcc, adc,
+ *           gpioinit, gpioen, status-async, vcc-async. `init` if none
+ */
+
+#include "ch9141.h"
+#include <unistd.h>
+
+#define REPLAY_RECORDS 4096 // Max number of trace records
+#define REPLAY_RX_TIMEOUT 200 // [ms]. Time taken by the receive call missing in the trace
+
+typedef struct replay_Record_s {
+    ch9141_TraceRecord_t header;
+    char payload[CH9141_TRACE_PAYLOAD_MAX];
+} replay_Record_t;
+
+static ch9141_ErrorStatus_t Replay_Receive(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
+static ch9141_ErrorStatus_t Replay_ReceivePoll(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
+static ch9141_ErrorStatus_t Replay_Transmit(void *handle, char const *pDataTx, uint16_t size);
+static ch9141_ErrorStatus_t Replay_BaudSet(void *handle, uint32_t baudRate);
+static void Replay_Delay(uint32_t ms);
+static uint32_t Replay_Tick(void);
+static void Replay_Pin(ch9141_PinState_t newState);
+static bool Trace_Load(FILE *file);
+static replay_Record_t *Trace_Next(bool rx);
+static bool Step_Run(ch9141_t *handle, char const *step);
+
+static replay_Record_t records[REPLAY_RECORDS];
+static uint32_t recordsNum;
+static uint32_t recordNext;
+static uint32_t divergences;
+static uint32_t now; // [ms]. Virtual time, in the trace time scale
+
+int main(int argc, char *argv[])
+{
+    static char *const defaultSteps[] = {"init"};
+    ch9141_t ble = {0};
+    FILE *file = stdin;
+    bool pins = false;
+    char *const *steps;
+    int stepsNum;
+    uint32_t start;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "pf:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'p':
+            pins = true;
+            break;
+
+        case 'f':
+            file = fopen(optarg, "r");
+            if (file == NULL)
+            {
+                perror(optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        default:
+            fprintf(stderr, "usage: %s [-p] [-f trace] [step...]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    steps = (optind < argc) ? &argv[optind] : defaultSteps;
+    stepsNum = (optind < argc) ? argc - optind : 1;
+
+    if (!Trace_Load(file))
+        return EXIT_FAILURE;
+    if (recordsNum != 0)
+        now = records[0].header.time;
+
+    ble.interface.receive = Replay_Receive;
+    ble.interface.receiveResponse = Replay_Receive;
+    ble.interface.receivePoll = Replay_ReceivePoll;
+    ble.interface.transmit = Replay_Transmit;
+    ble.interface.baudSet = Replay_BaudSet;
+    ble.interface.delay = Replay_Delay;
+    ble.interface.tick = Replay_Tick;
+    if (pins)
+    {
+        ble.interface.pinMode = Replay_Pin;
+        ble.interface.pinReset = Replay_Pin;
+        ble.interface.pinReload = Replay_Pin;
+        ble.interface.pinSleep = Replay_Pin;
+    }
+
+    /* Every step starts from the clean error state, as the board application would retry */
+    for (int i = 0; i < stepsNum; i++)
+    {
+        ble.error = CH9141_ERR_NONE;
+        start = now;
+        if (!Step_Run(&ble, steps[i]))
+        {
+            fprintf(stderr, "unknown step: %s\n", steps[i]);
+            return EXIT_FAILURE;
+        }
+        printf("{\"step\":\"%s\",\"ms\":%lu,\"error\":%u,\"error_at\":%u,\"record\":%lu}\n", steps[i],
+               (unsigned long) (now - start), ble.error, ble.errorAT, (unsigned long) recordNext);
+    }
+
+    printf("{\"records\":%lu,\"replayed\":%lu,\"divergences\":%lu}\n", (unsigned long) recordsNum,
+           (unsigned long) recordNext, (unsigned long) divergences);
+
+    return ((divergences == 0) && (recordNext == recordsNum)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Blocking receive: takes the next traced reception
+ */
+static ch9141_ErrorStatus_t Replay_Receive(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen)
+{
+    replay_Record_t *pRecord = Trace_Next(true);
+
+    (void) handle;
+
+    *rxLen = 0;
+    if ((pRecord == NULL) || (pRecord->header.kind == CH9141_TRACE_RX_POLL))
+    {
+        fprintf(stderr, "record %lu: unexpected receive\n", (unsigned long) recordNext);
+        divergences++;
+        now += REPLAY_RX_TIMEOUT;
+        return CH9141_ERROR_STATUS_ERROR;
+    }
+    recordNext++;
+
+    *rxLen = (pRecord->header.len < size) ? pRecord->header.len : size;
+    memcpy(pDataRx, pRecord->payload, *rxLen);
+    if ((int32_t) (pRecord->header.time - now) > 0)
+        now = pRecord->header.time;
+
+    return pRecord->header.ok ? CH9141_ERROR_STATUS_SUCCESS : CH9141_ERROR_STATUS_ERROR;
+}
+
+/**
+ * @brief Non-blocking receive: takes the next traced poll as soon as its time comes
+ */
+static ch9141_ErrorStatus_t Replay_ReceivePoll(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen)
+{
+    replay_Record_t *pRecord = Trace_Next(true);
+
+    (void) handle;
+
+    /* Polls with no data are not traced */
+    *rxLen = 0;
+    if ((pRecord == NULL) || (pRecord->header.kind != CH9141_TRACE_RX_POLL) ||
+        ((int32_t) (pRecord->header.time - now) > 0))
+        return CH9141_ERROR_STATUS_SUCCESS;
+    recordNext++;
+
+    *rxLen = (pRecord->header.len < size) ? pRecord->header.len : size;
+    memcpy(pDataRx, pRecord->payload, *rxLen);
+
+    return pRecord->header.ok ? CH9141_ERROR_STATUS_SUCCESS : CH9141_ERROR_STATUS_ERROR;
+}
+
+/**
+ * @brief Transmit: compares the data with the next traced transmission
+ */
+static ch9141_ErrorStatus_t Replay_Transmit(void *handle, char const *pDataTx, uint16_t size)
+{
+    replay_Record_t *pRecord = Trace_Next(false);
+    uint16_t len = (size < CH9141_TRACE_PAYLOAD_MAX) ? size : CH9141_TRACE_PAYLOAD_MAX;
+
+    (void) handle;
+
+    if (pRecord == NULL)
+    {
+        fprintf(stderr, "record %lu: unexpected transmit \"%.*s\"\n", (unsigned long) recordNext, (int) len, pDataTx);
+        divergences++;
+        return CH9141_ERROR_STATUS_SUCCESS;
+    }
+    recordNext++;
+
+    if ((pRecord->header.len != len) || (memcmp(pRecord->payload, pDataTx, len) != 0))
+    {
+        fprintf(stderr, "record %lu: transmit \"%.*s\" instead of \"%.*s\"\n", (unsigned long) recordNext, (int) len,
+                pDataTx, (int) pRecord->header.len, pRecord->payload);
+        divergences++;
+    }
+    if ((int32_t) (pRecord->header.time - now) > 0)
+        now = pRecord->header.time;
+
+    return pRecord->header.ok ? CH9141_ERROR_STATUS_SUCCESS : CH9141_ERROR_STATUS_ERROR;
+}
+
+/**
+ * @brief Baudrate changes are not traced, any one is accepted
+ */
+static ch9141_ErrorStatus_t Replay_BaudSet(void *handle, uint32_t baudRate)
+{
+    (void) handle;
+    (void) baudRate;
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+static void Replay_Delay(uint32_t ms)
+{
+    now += ms;
+}
+
+static uint32_t Replay_Tick(void)
+{
+    return now;
+}
+
+static void Replay_Pin(ch9141_PinState_t newState)
+{
+    (void) newState;
+}
+
+/**
+ * @brief Reads the trace printed by `CH9141_TraceDump`. Lines not matching the format are skipped
+ * @param file trace file
+ * @return `true` if the trace fits the record storage
+ */
+static bool Trace_Load(FILE *file)
+{
+    static char const *const kinds[] = {"TX", "RX", "RXR", "RXP"};
+    char line[64 + 2 * CH9141_TRACE_PAYLOAD_MAX];
+    char kind[4];
+    char hex[2 * CH9141_TRACE_PAYLOAD_MAX + 1];
+    unsigned long time;
+    unsigned ok;
+    unsigned state;
+    replay_Record_t *pRecord;
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (sscanf(line, "%lu %3s %u %u %128s", &time, kind, &ok, &state, hex) != 5)
+            continue;
+        if (recordsNum == REPLAY_RECORDS)
+        {
+            fprintf(stderr, "trace exceeds %u records\n", REPLAY_RECORDS);
+            return false;
+        }
+
+        pRecord = &records[recordsNum];
+        memset(pRecord, 0, sizeof(*pRecord));
+        pRecord->header.time = time;
+        pRecord->header.ok = ok;
+        pRecord->header.state = state;
+        pRecord->header.kind = UINT8_MAX;
+        for (uint8_t i = 0; i < sizeof(kinds) / sizeof(kinds[0]); i++)
+        {
+            if (strcmp(kind, kinds[i]) == 0)
+                pRecord->header.kind = i;
+        }
+        if (pRecord->header.kind == UINT8_MAX)
+            continue;
+
+        /* Payload as hex string, `-` if empty */
+        for (char const *pHex = hex; isxdigit((unsigned char) pHex[0]) && isxdigit((unsigned char) pHex[1]); pHex += 2)
+        {
+            char byte[3] = {pHex[0], pHex[1], '\0'};
+
+            pRecord->payload[pRecord->header.len++] = (char) strtoul(byte, NULL, 16);
+        }
+        recordsNum++;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Gets the next record to replay
+ * @param rx `true` for any receive call, `false` for transmit
+ * @return Pointer to the record or `NULL` if the trace is over or the next record is of the other direction
+ */
+static replay_Record_t *Trace_Next(bool rx)
+{
+    replay_Record_t *pRecord;
+
+    if (recordNext == recordsNum)
+        return NULL;
+
+    pRecord = &records[recordNext];
+
+    return ((pRecord->header.kind != CH9141_TRACE_TX) == rx) ? pRecord : NULL;
+}
+
+/**
+ * @brief Runs the driver call
+ * @param handle pointer to the device handle
+ * @param step call name
+ * @return `false` if the call name is unknown
+ */
+static bool Step_Run(ch9141_t *handle, char const *step)
+{
+    if (strcmp(step, "init") == 0)
+        CH9141_Init(handle, false);
+    else if (strcmp(step, "restore") == 0)
+        CH9141_Init(handle, true);
+    else if (strcmp(step, "serial") == 0)
+        CH9141_SerialGet(handle);
+    else if (strcmp(step, "hello") == 0)
+        CH9141_HelloGet(handle);
+    else if (strcmp(step, "name") == 0)
+        CH9141_DeviceNameGet(handle);
+    else if (strcmp(step, "chipname") == 0)
+        CH9141_ChipNameGet(handle);
+    else if (strcmp(step, "sleep") == 0)
+        CH9141_SleepGet(handle);
+    else if (strcmp(step, "power") == 0)
+        CH9141_PowerGet(handle);
+    else if (strcmp(step, "mode") == 0)
+        CH9141_ModeGet(handle);
+    else if (strcmp(step, "password") == 0)
+        CH9141_PasswordGet(handle);
+    else if (strcmp(step, "status") == 0)
+        CH9141_StatusGet(handle);
+    else if (strcmp(step, "mac") == 0)
+        CH9141_MACLocalGet(handle);
+    else if (strcmp(step, "remote") == 0)
+        CH9141_MACRemoteGet(handle);
+    else if (strcmp(step, "vcc") == 0)
+        CH9141_VCCGet(handle);
+    else if (strcmp(step, "adc") == 0)
+        CH9141_ADCGet(handle);
+    else if (strcmp(step, "gpioinit") == 0)
+        CH9141_GPIOInitGet(handle);
+    else if (strcmp(step, "gpioen") == 0)
+        CH9141_GPIOEnGet(handle);
+    else if ((strcmp(step, "status-async") == 0) || (strcmp(step, "vcc-async") == 0))
+    {
+        if (step[0] == 's')
+            CH9141_StatusGetAsync(handle);
+        else
+            CH9141_VCCGetAsync(handle);
+        while (CH9141_Process(handle, now))
+            Replay_Delay(1);
+    }
+    else
+        return false;
+
+    return true;
+}
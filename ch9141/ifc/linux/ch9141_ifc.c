@@ -0,0 +1,383 @@
+#include "ch9141_ifc.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/serial.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CH9141_RX_TIMEOUT 200
+#define CH9141_TX_TIMEOUT 2000
+#define CH9141_RX_IDLE_GAP 3 // [ms]. Silence treated as the end of the message, covers USB-UART adapter latency
+
+static ch9141_ErrorStatus_t Tty_Receive(ch9141_Tty_t *tty, char *pDataRx, uint16_t size, uint16_t *rxLen,
+                                        bool response);
+static void Tty_Line(ch9141_Tty_t *tty, int line, ch9141_PinState_t newState);
+static speed_t Tty_Speed(uint32_t baudRate);
+static uint32_t Tty_Millis(void);
+
+ch9141_Tty_t ch9141_tty1 = {.fd = -1};
+
+ch9141_ErrorStatus_t CH9141_TTY_Open(ch9141_Tty_t *tty, char const *path, uint32_t baudRate)
+{
+    struct termios options;
+    struct serial_struct serial;
+    int lines;
+    speed_t speed = Tty_Speed(baudRate);
+
+    if (tty == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (path == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (speed == B0)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    tty->fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (tty->fd < 0)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Raw 8N1, no flow control, reads never block: timing is handled by poll() */
+    if (tcgetattr(tty->fd, &options) != 0)
+    {
+        CH9141_TTY_Close(tty);
+        return CH9141_ERROR_STATUS_ERROR;
+    }
+    cfmakeraw(&options);
+    options.c_cflag |= CLOCAL | CREAD;
+    options.c_cflag &= ~(CRTSCTS | HUPCL | CSTOPB);
+    options.c_cc[VMIN] = 0;
+    options.c_cc[VTIME] = 0;
+    cfsetispeed(&options, speed);
+    cfsetospeed(&options, speed);
+    if (tcsetattr(tty->fd, TCSANOW, &options) != 0)
+    {
+        CH9141_TTY_Close(tty);
+        return CH9141_ERROR_STATUS_ERROR;
+    }
+    tty->baudRate = baudRate;
+
+    /* Low latency mode makes the tty driver push received data immediately, not supported by every adapter */
+    if (ioctl(tty->fd, TIOCGSERIAL, &serial) == 0)
+    {
+        serial.flags |= ASYNC_LOW_LATENCY;
+        ioctl(tty->fd, TIOCSSERIAL, &serial);
+    }
+
+    /* Opening the port asserts the modem lines: release the chip */
+    tty->modemLines = ioctl(tty->fd, TIOCMGET, &lines) == 0;
+    Tty_Line(tty, TIOCM_DTR, CH9141_PIN_STATE_SET);
+    Tty_Line(tty, TIOCM_RTS, CH9141_PIN_STATE_SET);
+    tcflush(tty->fd, TCIOFLUSH);
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+void CH9141_TTY_Close(ch9141_Tty_t *tty)
+{
+    if ((tty == NULL) || (tty->fd < 0))
+        return;
+
+    close(tty->fd);
+    tty->fd = -1;
+}
+
+ch9141_ErrorStatus_t CH9141_UART_Receive(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen)
+{
+    if (handle == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (pDataRx == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (size == 0u)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    return Tty_Receive((ch9141_Tty_t *) handle, pDataRx, size, rxLen, false);
+}
+
+ch9141_ErrorStatus_t CH9141_UART_ReceiveResponse(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen)
+{
+    if (handle == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (pDataRx == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (size == 0u)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    return Tty_Receive((ch9141_Tty_t *) handle, pDataRx, size, rxLen, true);
+}
+
+ch9141_ErrorStatus_t CH9141_UART_ReceivePoll(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen)
+{
+    ch9141_Tty_t *tty = (ch9141_Tty_t *) handle;
+    ssize_t n;
+
+    if (tty == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (pDataRx == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (rxLen == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    *rxLen = 0;
+    if (size == 0u)
+        return CH9141_ERROR_STATUS_SUCCESS;
+
+    n = read(tty->fd, pDataRx, size);
+    if (n < 0)
+        return ((errno == EAGAIN) || (errno == EINTR)) ? CH9141_ERROR_STATUS_SUCCESS : CH9141_ERROR_STATUS_ERROR;
+    *rxLen = (uint16_t) n;
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+ch9141_ErrorStatus_t CH9141_UART_Transmit(void *handle, char const *pDataTx, uint16_t size)
+{
+    ch9141_Tty_t *tty = (ch9141_Tty_t *) handle;
+    uint32_t start = Tty_Millis();
+    uint32_t elapsed;
+    uint16_t len = 0;
+    ssize_t n;
+
+    if (tty == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (pDataTx == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (size == 0u)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    while (len < size)
+    {
+        n = write(tty->fd, &pDataTx[len], size - len);
+        if (n > 0)
+        {
+            len += n;
+            continue;
+        }
+        if ((n < 0) && (errno != EAGAIN) && (errno != EINTR))
+            return CH9141_ERROR_STATUS_ERROR;
+
+        /* Output buffer is full */
+        elapsed = Tty_Millis() - start;
+        if (elapsed >= CH9141_TX_TIMEOUT)
+            return CH9141_ERROR_STATUS_ERROR;
+        struct pollfd pfd = {.fd = tty->fd, .events = POLLOUT};
+        poll(&pfd, 1, CH9141_TX_TIMEOUT - elapsed);
+    }
+
+    /* Return when the data is on the wire, as the blocking platform transmit does: the chip timing rules count from
+     * the last byte */
+    return tcdrain(tty->fd) == 0 ? CH9141_ERROR_STATUS_SUCCESS : CH9141_ERROR_STATUS_ERROR;
+}
+
+ch9141_ErrorStatus_t CH9141_UART_BaudSet(void *handle, uint32_t baudRate)
+{
+    ch9141_Tty_t *tty = (ch9141_Tty_t *) handle;
+    struct termios options;
+    speed_t speed = Tty_Speed(baudRate);
+
+    if (tty == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (speed == B0)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    if (tcgetattr(tty->fd, &options) != 0)
+        return CH9141_ERROR_STATUS_ERROR;
+    cfsetispeed(&options, speed);
+    cfsetospeed(&options, speed);
+    if (tcsetattr(tty->fd, TCSANOW, &options) != 0)
+        return CH9141_ERROR_STATUS_ERROR;
+    tty->baudRate = baudRate;
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+void CH9141_Delay(uint32_t ms)
+{
+    struct timespec ts = {.tv_sec = ms / 1000u, .tv_nsec = (long) (ms % 1000u) * 1000000L};
+
+    while ((nanosleep(&ts, &ts) != 0) && (errno == EINTR))
+        ;
+}
+
+uint32_t CH9141_Tick(void)
+{
+    return Tty_Millis();
+}
+
+void CH9141_Pin_Mode1(ch9141_PinState_t newState)
+{
+    Tty_Line(&ch9141_tty1, TIOCM_DTR, newState);
+}
+
+void CH9141_Pin_Reset1(ch9141_PinState_t newState)
+{
+    Tty_Line(&ch9141_tty1, TIOCM_RTS, newState);
+}
+
+ch9141_ErrorStatus_t CH9141_SetUp(ch9141_t *ble, char const *path, uint32_t baudRate)
+{
+    if (ble == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    if (CH9141_TTY_Open(&ch9141_tty1, path, baudRate) != CH9141_ERROR_STATUS_SUCCESS)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Initialize the ble interface */
+    memset(ble, 0, sizeof(ch9141_t));
+    ble->interface.handle = &ch9141_tty1;
+    ble->interface.receive = CH9141_UART_Receive;
+    ble->interface.receiveResponse = CH9141_UART_ReceiveResponse;
+    ble->interface.receivePoll = CH9141_UART_ReceivePoll;
+    ble->interface.transmit = CH9141_UART_Transmit;
+    ble->interface.baudSet = CH9141_UART_BaudSet;
+    ble->interface.delay = CH9141_Delay;
+    ble->interface.tick = CH9141_Tick;
+    if (ch9141_tty1.modemLines)
+    {
+        ble->interface.pinMode = CH9141_Pin_Mode1;
+        ble->interface.pinReset = CH9141_Pin_Reset1;
+    }
+    CH9141_Init(ble, false);
+
+    return (ble->error != CH9141_ERR_NONE) ? CH9141_ERROR_STATUS_ERROR : CH9141_ERROR_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Internal function used to receive the message. Mirrors `HAL_UARTEx_ReceiveToIdle`: waits for the first byte
+ * up to the receive timeout, then completes on idle line
+ * @param tty pointer to the serial port instance
+ * @param pDataRx pointer to the buffer where data will be saved
+ * @param size number of bytes to read
+ * @param rxLen pointer to variable to keep the number of bytes actually received
+ * @param response `true` to complete on AT response terminator instead of idle line
+ * @return Status of the data transfer request operation
+ */
+static ch9141_ErrorStatus_t Tty_Receive(ch9141_Tty_t *tty, char *pDataRx, uint16_t size, uint16_t *rxLen,
+                                        bool response)
+{
+    struct pollfd pfd = {.fd = tty->fd, .events = POLLIN};
+    uint32_t start = Tty_Millis();
+    uint32_t elapsed;
+    uint32_t wait;
+    uint16_t len = 0;
+    ssize_t n;
+    int ready;
+
+    while (len < size)
+    {
+        if (response && CH9141_ResponseIsComplete(pDataRx, len))
+            break;
+
+        elapsed = Tty_Millis() - start;
+        if (elapsed >= CH9141_RX_TIMEOUT)
+            break;
+        wait = CH9141_RX_TIMEOUT - elapsed;
+        if (!response && (len != 0) && (wait > CH9141_RX_IDLE_GAP))
+            wait = CH9141_RX_IDLE_GAP;
+
+        ready = poll(&pfd, 1, (int) wait);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (ready == 0)
+        {
+            if (!response && (len != 0))
+                break; // Idle line
+            continue;
+        }
+
+        n = read(tty->fd, &pDataRx[len], size - len);
+        if ((n < 0) && (errno != EAGAIN) && (errno != EINTR))
+            break;
+        if (n > 0)
+            len += n;
+    }
+
+    if (len < size)
+        pDataRx[len] = '\0';
+    if (rxLen != NULL)
+        *rxLen = len;
+
+    return len != 0 ? CH9141_ERROR_STATUS_SUCCESS : CH9141_ERROR_STATUS_ERROR;
+}
+
+/**
+ * @brief Internal function used to drive the chip pin through the modem control line
+ * @param tty pointer to the serial port instance
+ * @param line `TIOCM_DTR` or `TIOCM_RTS`
+ * @param newState new pin state
+ */
+static void Tty_Line(ch9141_Tty_t *tty, int line, ch9141_PinState_t newState)
+{
+    if ((tty->fd < 0) || !tty->modemLines)
+        return;
+
+    switch (newState)
+    {
+    case CH9141_PIN_STATE_SET:
+        ioctl(tty->fd, TIOCMBIC, &line); // Deasserted line drives the pin high
+        break;
+
+    case CH9141_PIN_STATE_RESET:
+        ioctl(tty->fd, TIOCMBIS, &line);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Internal function used to convert the baudrate to termios speed
+ * @param baudRate serial port baudrate
+ * @return termios speed, `B0` if the baudrate is not supported
+ */
+static speed_t Tty_Speed(uint32_t baudRate)
+{
+    switch (baudRate)
+    {
+    case 1200:
+        return B1200;
+    case 2400:
+        return B2400;
+    case 4800:
+        return B4800;
+    case 9600:
+        return B9600;
+    case 19200:
+        return B19200;
+    case 38400:
+        return B38400;
+    case 57600:
+        return B57600;
+    case 115200:
+        return B115200;
+    case 230400:
+        return B230400;
+    case 460800:
+        return B460800;
+    case 921600:
+        return B921600;
+    case 1000000:
+        return B1000000;
+    default:
+        return B0;
+    }
+}
+
+/**
+ * @brief Internal function used to get monotonic time
+ * @return Current time [ms]
+ */
+static uint32_t Tty_Millis(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t) ts.tv_sec * 1000u + (uint32_t) (ts.tv_nsec / 1000000L);
+}
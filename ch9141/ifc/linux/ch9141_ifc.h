@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ch9141.h"
+
+/**
+ * @file ch9141_ifc.h
+ * @brief Linux interface port: CH9141 attached to the host through a USB-UART adapter (termios tty). Modem control
+ * lines drive the chip pins: DTR -> Mode, RTS -> Reset. Lines are active low on the adapter side, so asserted line
+ * means low pin level. Reload and Sleep pins are not wired.
+ *
+ * gcc -I ch9141/driver -I ch9141/ifc/linux ch9141/driver/ch9141.c ch9141/ifc/linux/ch9141_ifc.c app.c
+ */
+
+/* Serial port instance */
+typedef struct ch9141_Tty_s {
+    int fd;
+    uint32_t baudRate;
+    bool modemLines; // Port has DTR/RTS lines (pseudo terminals do not)
+} ch9141_Tty_t;
+
+/* Default instance used by `CH9141_Pin_x1` functions */
+extern ch9141_Tty_t ch9141_tty1;
+
+/**
+ * @brief Opens the serial port in raw 8N1 mode without flow control and requests low latency mode from the tty driver.
+ * Mode and Reset lines are released (high pin level)
+ * @param tty pointer to the serial port instance
+ * @param path tty device path, e.g. "/dev/ttyUSB0"
+ * @param baudRate serial port baudrate
+ * @return Status of the operation
+ */
+ch9141_ErrorStatus_t CH9141_TTY_Open(ch9141_Tty_t *tty, char const *path, uint32_t baudRate);
+
+/**
+ * @brief Closes the serial port
+ * @param tty pointer to the serial port instance
+ */
+void CH9141_TTY_Close(ch9141_Tty_t *tty);
+
+/* Interface functions. `interface.handle` must point to the serial port instance */
+ch9141_ErrorStatus_t CH9141_UART_Receive(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
+ch9141_ErrorStatus_t CH9141_UART_ReceiveResponse(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
+ch9141_ErrorStatus_t CH9141_UART_ReceivePoll(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
+ch9141_ErrorStatus_t CH9141_UART_Transmit(void *handle, char const *pDataTx, uint16_t size);
+ch9141_ErrorStatus_t CH9141_UART_BaudSet(void *handle, uint32_t baudRate);
+void CH9141_Delay(uint32_t ms);
+uint32_t CH9141_Tick(void);
+void CH9141_Pin_Mode1(ch9141_PinState_t newState);
+void CH9141_Pin_Reset1(ch9141_PinState_t newState);
+
+/**
+ * @brief Opens `ch9141_tty1`, fills the interface of the handle and initializes the chip. Pin functions are used only
+ * if the port has modem control lines, otherwise the driver works in software AT mode
+ * @param ble pointer to the device handle
+ * @param path tty device path
+ * @param baudRate serial port baudrate
+ * @return Status of the operation
+ */
+ch9141_ErrorStatus_t CH9141_SetUp(ch9141_t *ble, char const *path, uint32_t baudRate);
@@ -2,6 +2,60 @@
 
 #define CH9141_RX_TIMEOUT 200
 #define CH9141_TX_TIMEOUT 2000
+#define CH9141_RX_DMA_SIZE 256 // Circular DMA buffer drained on half transfer, full transfer and idle line events
+#define CH9141_RX_RING_SIZE 1024 // Must be power of 2
+#define CH9141_RX_IDLE_GAP 2 // [ms]. Silence treated as the end of the message by the ring buffer receive
+#define CH9141_TX_QUEUE_SIZE 8 // Must be power of 2
+#define CH9141_AT_QUEUE_SIZE 4 // Must be power of 2
+
+/* Lock-free ring buffer: single producer (UART/DMA interrupts), single consumer (application) */
+typedef struct ch9141_Ring_s {
+    uint8_t data[CH9141_RX_RING_SIZE];
+    volatile uint32_t head; // Written by the producer only
+    volatile uint32_t tail; // Written by the consumer only
+    volatile uint32_t dropped; // Number of bytes lost due to the ring overflow
+} ch9141_Ring_t;
+
+/* Transmit descriptor. The data is not copied: the buffer is owned by the queue until `done` is called */
+typedef struct ch9141_TxDesc_s {
+    uint8_t const *pData;
+    uint16_t size;
+    ch9141_TxDone_fp done;
+    void *context;
+} ch9141_TxDesc_t;
+
+/* Queued AT job */
+typedef struct ch9141_AtJob_s {
+    ch9141_AtJob_fp job;
+    void *context;
+} ch9141_AtJob_t;
+
+static void Ring_Put(ch9141_Ring_t *ring, uint8_t const *pData, uint16_t size);
+static uint16_t Ring_Read(ch9141_Ring_t *ring, char *pData, uint16_t size);
+static void Rx_Drain(uint16_t pos);
+static void Rx_Switch(ch9141_Ring_t *ring);
+static void Tx_Next(void);
+static void Arbiter_ErrorTake(ch9141_t *ble);
+static ch9141_ErrorStatus_t Ring_Receive(char *pDataRx, uint16_t size, uint16_t *rxLen, bool response);
+
+static uint8_t rxDMA[CH9141_RX_DMA_SIZE];
+static uint16_t rxDMAPos; // Position within DMA buffer already moved to the ring
+static ch9141_Ring_t rxRing;
+static ch9141_Ring_t rxAtRing; // AT responses received within the arbiter session
+static ch9141_Ring_t *volatile rxTarget = &rxRing; // Ring fed by the reception interrupts
+static volatile bool rxRunning;
+static ch9141_TxDesc_t txQueue[CH9141_TX_QUEUE_SIZE];
+static volatile uint32_t txHead; // Written by the application only
+static volatile uint32_t txTail; // Written by the transfer complete interrupt only
+static volatile bool txBusy;
+static volatile bool txPaused; // Next descriptor is not started, the current one completes
+static ch9141_AtJob_t atQueue[CH9141_AT_QUEUE_SIZE];
+static uint32_t atHead;
+static uint32_t atTail;
+static volatile bool atSession; // Driver owns UART4 on behalf of the arbiter
+static bool atPausing; // Transmit queue is paused, waiting for the current frame to complete
+static uint32_t atPauseStart;
+static ch9141_ArbiterStats_t atStats;
 
 ch9141_ErrorStatus_t CH9141_UART_Receive(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen)
 {
@@ -12,16 +66,82 @@ ch9141_ErrorStatus_t CH9141_UART_Receive(void *handle, char *pDataRx, uint16_t s
     if (size == 0u)
         return CH9141_ERROR_STATUS_ERROR;
 
+    /* Background reception is running */
+    if (rxRunning && (handle == &huart4))
+        return Ring_Receive(pDataRx, size, rxLen, false);
+
     /* Abort ongoing reception if necessary */
-    UART_HandleTypeDef huart = *(UART_HandleTypeDef *) handle;
-    if (huart.RxState != HAL_UART_STATE_READY)
-        HAL_UART_AbortReceive(&huart);
+    UART_HandleTypeDef *huart = handle;
+    if (huart->RxState != HAL_UART_STATE_READY)
+        HAL_UART_AbortReceive(huart);
 
-    return HAL_UARTEx_ReceiveToIdle(&huart, (uint8_t *) pDataRx, size, rxLen, CH9141_RX_TIMEOUT) == HAL_OK
+    return HAL_UARTEx_ReceiveToIdle(huart, (uint8_t *) pDataRx, size, rxLen, CH9141_RX_TIMEOUT) == HAL_OK
                ? CH9141_ERROR_STATUS_SUCCESS
                : CH9141_ERROR_STATUS_ERROR;
 }
 
+ch9141_ErrorStatus_t CH9141_UART_ReceiveResponse(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen)
+{
+    uint32_t start = HAL_GetTick();
+    uint32_t elapsed;
+    uint16_t len = 0;
+    uint16_t part;
+
+    if (handle == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (pDataRx == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (size == 0u)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Background reception is running */
+    if (rxRunning && (handle == &huart4))
+        return Ring_Receive(pDataRx, size, rxLen, true);
+
+    /* Abort ongoing reception if necessary */
+    UART_HandleTypeDef *huart = handle;
+    if (huart->RxState != HAL_UART_STATE_READY)
+        HAL_UART_AbortReceive(huart);
+
+    /* Receive up to the idle line until the response is complete, buffer is full or timeout expires */
+    while (!CH9141_ResponseIsComplete(pDataRx, len) && (len < size))
+    {
+        elapsed = HAL_GetTick() - start;
+        if (elapsed >= CH9141_RX_TIMEOUT)
+            break;
+        part = 0;
+        if (HAL_UARTEx_ReceiveToIdle(huart, (uint8_t *) &pDataRx[len], size - len, &part,
+                                     CH9141_RX_TIMEOUT - elapsed) != HAL_OK)
+            break;
+        len += part;
+    }
+
+    if (len < size)
+        pDataRx[len] = '\0';
+    if (rxLen != NULL)
+        *rxLen = len;
+
+    return len != 0 ? CH9141_ERROR_STATUS_SUCCESS : CH9141_ERROR_STATUS_ERROR;
+}
+
+ch9141_ErrorStatus_t CH9141_UART_ReceivePoll(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen)
+{
+    if (handle == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (pDataRx == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if (rxLen == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Only background reception can be polled */
+    if (!rxRunning || (handle != &huart4))
+        return CH9141_ERROR_STATUS_ERROR;
+
+    *rxLen = Ring_Read(atSession ? &rxAtRing : &rxRing, pDataRx, size);
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
 ch9141_ErrorStatus_t CH9141_UART_Transmit(void *handle, char const *pDataTx, uint16_t size)
 {
     if (handle == NULL)
@@ -31,21 +151,71 @@ ch9141_ErrorStatus_t CH9141_UART_Transmit(void *handle, char const *pDataTx, uin
     if (size == 0u)
         return CH9141_ERROR_STATUS_ERROR;
 
+    /* Within the arbiter session the stream received so far stays for the application, the rest is AT responses */
+    if (rxRunning && (handle == &huart4) && atSession && (rxTarget != &rxAtRing))
+        Rx_Switch(&rxAtRing);
+
+    /* Response to the request is expected next: drop unread data */
+    if (rxRunning && (handle == &huart4))
+        rxTarget->tail = rxTarget->head;
+
+    /* Let queued data go out first, the queue must not be aborted */
+    if (handle == &huart4)
+    {
+        uint32_t start = HAL_GetTick();
+        while (txBusy)
+        {
+            if (HAL_GetTick() - start >= CH9141_TX_TIMEOUT)
+                return CH9141_ERROR_STATUS_ERROR;
+        }
+    }
+
     /* Abort ongoing transmission if necessary */
-    UART_HandleTypeDef huart = *(UART_HandleTypeDef *) handle;
-    if (huart.gState != HAL_UART_STATE_READY)
-        HAL_UART_AbortTransmit(&huart);
+    UART_HandleTypeDef *huart = handle;
+    if (huart->gState != HAL_UART_STATE_READY)
+        HAL_UART_AbortTransmit(huart);
 
-    return HAL_UART_Transmit(&huart, (uint8_t const *) pDataTx, size, CH9141_TX_TIMEOUT) == HAL_OK
+    return HAL_UART_Transmit(huart, (uint8_t const *) pDataTx, size, CH9141_TX_TIMEOUT) == HAL_OK
                ? CH9141_ERROR_STATUS_SUCCESS
                : CH9141_ERROR_STATUS_ERROR;
 }
 
+ch9141_ErrorStatus_t CH9141_UART_BaudSet(void *handle, uint32_t baudRate)
+{
+    UART_HandleTypeDef *huart = (UART_HandleTypeDef *) handle;
+    bool rxRestart = rxRunning && (handle == &huart4);
+
+    if (huart == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+    if ((baudRate == 0) || (baudRate > 1000000))
+        return CH9141_ERROR_STATUS_ERROR;
+    if (txBusy && (handle == &huart4))
+        return CH9141_ERROR_STATUS_ERROR; // Queued data would be sent at the wrong baudrate
+
+    /* Background reception is stopped while the UART is reconfigured */
+    if (rxRestart)
+        CH9141_RxStop();
+
+    huart->Init.BaudRate = baudRate;
+    if (HAL_UART_Init(huart) != HAL_OK)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    if (rxRestart && (CH9141_RxStart() == ERROR))
+        return CH9141_ERROR_STATUS_ERROR;
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
 void CH9141_Delay(uint32_t ms)
 {
     HAL_Delay(ms);
 }
 
+uint32_t CH9141_Tick(void)
+{
+    return HAL_GetTick();
+}
+
 void CH9141_Pin_Mode1(ch9141_PinState_t newState)
 {
     switch (newState)
@@ -114,13 +284,213 @@ void CH9141_Pin_Sleep1(ch9141_PinState_t newState)
     }
 }
 
+ErrorStatus CH9141_RxStart(void)
+{
+    rxRunning = false;
+    rxDMAPos = 0;
+    if (atSession)
+        rxTarget = &rxAtRing; // Restarted within the arbiter session, e.g. on baudrate change
+    rxTarget->tail = rxTarget->head;
+
+    if (HAL_UARTEx_ReceiveToIdle_DMA(&huart4, rxDMA, sizeof(rxDMA)) != HAL_OK)
+        return ERROR;
+
+    rxRunning = true;
+
+    return SUCCESS;
+}
+
+void CH9141_RxStop(void)
+{
+    rxRunning = false;
+    HAL_UART_AbortReceive(&huart4);
+}
+
+uint16_t CH9141_Available(void)
+{
+    return rxRing.head - rxRing.tail;
+}
+
+uint16_t CH9141_Read(char *pData, uint16_t size)
+{
+    return Ring_Read(&rxRing, pData, size);
+}
+
+uint32_t CH9141_RxDropped(void)
+{
+    return rxRing.dropped;
+}
+
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+    if (huart->Instance != UART4)
+        return;
+
+    /* DMA position is read from the counter rather than `Size`: the arbiter may have drained ahead of the event */
+    Rx_Drain(sizeof(rxDMA) - __HAL_DMA_GET_COUNTER(huart->hdmarx));
+}
+
+ErrorStatus CH9141_TxQueue(void const *pData, uint16_t size, ch9141_TxDone_fp done, void *context)
+{
+    uint32_t head = txHead;
+    uint32_t primask;
+
+    if ((pData == NULL) || (size == 0u))
+        return ERROR;
+    if (head - txTail == CH9141_TX_QUEUE_SIZE)
+        return ERROR;
+
+    txQueue[head & (CH9141_TX_QUEUE_SIZE - 1)] = (ch9141_TxDesc_t) {pData, size, done, context};
+
+    /* Descriptor is written before the head index */
+    __DMB();
+    txHead = head + 1;
+
+    /* Start the transfer unless the interrupt chains it */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (!txBusy)
+        Tx_Next();
+    __set_PRIMASK(primask);
+
+    return SUCCESS;
+}
+
+uint16_t CH9141_TxPending(void)
+{
+    return txHead - txTail;
+}
+
+ErrorStatus CH9141_AtSubmit(ch9141_AtJob_fp job, void *context)
+{
+    if (job == NULL)
+        return ERROR;
+    if (atHead - atTail == CH9141_AT_QUEUE_SIZE)
+        return ERROR;
+
+    atQueue[atHead & (CH9141_AT_QUEUE_SIZE - 1)] = (ch9141_AtJob_t) {job, context};
+    atHead++;
+
+    return SUCCESS;
+}
+
+void CH9141_ArbiterProcess(ch9141_t *ble)
+{
+    ch9141_AtJob_t job;
+    ch9141_Error_t error;
+    uint32_t primask;
+    uint32_t pause;
+
+    if (ble == NULL)
+        return;
+
+    /* Transmit queue stops at the frame boundary */
+    if (!atPausing)
+    {
+        if (atTail == atHead)
+            return;
+        atPauseStart = HAL_GetTick();
+        atPausing = true;
+        txPaused = true;
+    }
+    if (txBusy)
+        return;
+
+    /* Asynchronous operation owns the device until completion */
+    if (ble->async.active)
+        return;
+
+    /* Handle error is sticky: application one is kept aside, each job starts clean */
+    error = ble->error;
+    ble->error = CH9141_ERR_NONE;
+    atSession = true;
+    CH9141_SessionBegin(ble);
+    while (atTail != atHead)
+    {
+        job = atQueue[atTail & (CH9141_AT_QUEUE_SIZE - 1)];
+        job.job(ble, job.context);
+        atTail++;
+        atStats.jobs++;
+        Arbiter_ErrorTake(ble);
+    }
+    CH9141_SessionEnd(ble);
+    Arbiter_ErrorTake(ble);
+    ble->error = error;
+
+    /* Stream received from now on is for the application again */
+    if (rxRunning && (rxTarget != &rxRing))
+        Rx_Switch(&rxRing);
+    atSession = false;
+
+    /* Resume the queued frames */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    txPaused = false;
+    if (!txBusy)
+        Tx_Next();
+    __set_PRIMASK(primask);
+    atPausing = false;
+
+    pause = HAL_GetTick() - atPauseStart;
+    atStats.sessions++;
+    atStats.pauseLast = pause;
+    atStats.pauseTotal += pause;
+    if (pause > atStats.pauseMax)
+        atStats.pauseMax = pause;
+}
+
+void CH9141_ArbiterStatsGet(ch9141_ArbiterStats_t *stats)
+{
+    if (stats == NULL)
+        return;
+
+    *stats = atStats;
+}
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance != UART4)
+        return;
+
+    ch9141_TxDesc_t desc = txQueue[txTail & (CH9141_TX_QUEUE_SIZE - 1)];
+
+    /* Release the descriptor before its buffer returns to the owner */
+    txTail++;
+    Tx_Next();
+    if (desc.done != NULL)
+        desc.done(desc.pData, desc.size, desc.context, true);
+}
+
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance != UART4)
+        return;
+
+    /* Transmission is aborted on DMA error: report the failed buffer and go on with the rest */
+    if (txBusy && (huart->gState == HAL_UART_STATE_READY))
+    {
+        ch9141_TxDesc_t desc = txQueue[txTail & (CH9141_TX_QUEUE_SIZE - 1)];
+
+        txTail++;
+        Tx_Next();
+        if (desc.done != NULL)
+            desc.done(desc.pData, desc.size, desc.context, false);
+    }
+
+    if (!rxRunning)
+        return;
+
+    /* Reception is aborted on overrun, noise or framing error: restart it */
+    rxDMAPos = 0;
+    if (HAL_UARTEx_ReceiveToIdle_DMA(&huart4, rxDMA, sizeof(rxDMA)) != HAL_OK)
+        rxRunning = false;
+}
+
 ErrorStatus CH9141_SetUp(ch9141_t *ble)
 {
-    const char *deviceName = "TAG044";
-    const char *chipName = "RTS044";
+    ch9141_Config_t config = CH9141_CONFIG_KEEP;
+    static const uint32_t baudCandidates[] = {115200, 1000000, 921600, 460800, 230400};
     const uint8_t attempts = 3;
-    char bleResponse[50] = {0};
-    ErrorStatus cmpResult = SUCCESS;
 
     if (ble == NULL)
         return ERROR;
@@ -129,61 +499,209 @@ ErrorStatus CH9141_SetUp(ch9141_t *ble)
     memset(ble, 0, sizeof(ch9141_t));
     ble->interface.handle = &huart4;
     ble->interface.receive = CH9141_UART_Receive;
+    ble->interface.receiveResponse = CH9141_UART_ReceiveResponse;
+    ble->interface.receivePoll = CH9141_UART_ReceivePoll;
     ble->interface.transmit = CH9141_UART_Transmit;
+    ble->interface.baudSet = CH9141_UART_BaudSet;
     ble->interface.delay = CH9141_Delay;
+    ble->interface.tick = CH9141_Tick;
     ble->interface.pinMode = CH9141_Pin_Mode1;
     ble->interface.pinSleep = CH9141_Pin_Sleep1;
     ble->interface.pinReset = CH9141_Pin_Reset1;
     ble->interface.pinReload = CH9141_Pin_Reload1;
+    ble->baudCandidates = baudCandidates; // Factory one or the one negotiated below last time
+    ble->baudCandidatesNum = sizeof(baudCandidates) / sizeof(baudCandidates[0]);
     CH9141_Init(ble, false);
     if (ble->error != CH9141_ERR_NONE)
         return ERROR;
 
-    /* Check device name */
-    strncpy(bleResponse, CH9141_DeviceNameGet(ble), ble->responseLen);
-    if (strcmp(bleResponse, deviceName) != 0)
+    /* Desired configuration, the rest is kept */
+    config.deviceName = "TAG044";
+    config.chipName = "RTS044";
+    config.power = CH9141_POWER_3DB;
+    config.sleepMode = CH9141_SLEEPMODE_LOW_ENERGY;
+    config.mode = CH9141_MODE_DEVICE;
+    config.gpioEn = 0xF0;
+
+    /* Write only the parameters which differ from the desired ones */
+    CH9141_Apply(ble, &config);
+    for (uint8_t i = 0; (i < attempts) && (ble->error != CH9141_ERR_NONE); i++)
     {
-        for (size_t i = 0; i < attempts; i++)
-        {
-            cmpResult = SUCCESS;
-
-            /* New or unknown device, need to factory restore and set up */
-            CH9141_Init(ble, true); // Factory restore
-
-            /* Device name */
-            CH9141_DeviceNameSet(ble, deviceName);
-            strncpy(bleResponse, CH9141_DeviceNameGet(ble), ble->responseLen);
-            if (strcmp(bleResponse, deviceName) != 0)
-            {
-                cmpResult = ERROR;
-                continue;
-            }
-
-            /* Chip name */
-            CH9141_ChipNameSet(ble, chipName);
-            strncpy(bleResponse, CH9141_ChipNameGet(ble), ble->responseLen);
-            if (strcmp(bleResponse, chipName) != 0)
-            {
-                cmpResult = ERROR;
-                continue;
-            }
-
-            CH9141_SleepSet(ble, CH9141_SLEEPMODE_LOW_ENERGY);
-            CH9141_PowerSet(ble, CH9141_POWER_3DB);
-            CH9141_ModeSet(ble, CH9141_MODE_DEVICE);
-            CH9141_GPIOEnSet(ble, 0xF0);
-            // CH9141_GPIOInitSet(ble, 1 << 6 | 1 << 7);
-            // CH9141_PasswordSet(ble, "093728", CH9141_FUNC_STATE_ENABLE);
-
-            if (ble->error == CH9141_ERR_NONE)
-                break;
-        }
+        /* Device refuses the settings, need to factory restore and set up again */
+        CH9141_Init(ble, true); // Factory restore
+        CH9141_Apply(ble, &config);
     }
 
+    /* Transparent throughput is limited by the baudrate */
+    CH9141_BaudNegotiate(ble, 1000000);
+
     /* Force gpio5-7 to input mode */
+    CH9141_SessionBegin(ble);
     CH9141_GPIOGet(ble, 5);
     CH9141_GPIOGet(ble, 6);
     CH9141_GPIOGet(ble, 7);
+    CH9141_SessionEnd(ble);
 
-    return (cmpResult == ERROR || ble->error != CH9141_ERR_NONE) ? ERROR : SUCCESS;
-}
\ No newline at end of file
+    return (ble->error != CH9141_ERR_NONE) ? ERROR : SUCCESS;
+}
+
+/**
+ * @brief Internal function used to put the data to the ring buffer. Called by the producer only
+ * @param ring pointer to the ring buffer
+ * @param pData pointer to the data
+ * @param size number of bytes
+ */
+static void Ring_Put(ch9141_Ring_t *ring, uint8_t const *pData, uint16_t size)
+{
+    uint32_t head = ring->head;
+
+    for (uint16_t i = 0; i < size; i++)
+    {
+        if (head - ring->tail == CH9141_RX_RING_SIZE)
+        {
+            ring->dropped += size - i;
+            break;
+        }
+        ring->data[head & (CH9141_RX_RING_SIZE - 1)] = pData[i];
+        head++;
+    }
+
+    /* Data is written before the head index */
+    __DMB();
+    ring->head = head;
+}
+
+/**
+ * @brief Internal function used to read the data from the ring buffer. Called by the consumer only
+ * @param ring pointer to the ring buffer
+ * @param pData pointer to the buffer where data will be saved
+ * @param size max number of bytes to read
+ * @return Number of bytes read
+ */
+static uint16_t Ring_Read(ch9141_Ring_t *ring, char *pData, uint16_t size)
+{
+    uint32_t tail = ring->tail;
+    uint32_t available = ring->head - tail;
+    uint16_t len;
+
+    if (pData == NULL)
+        return 0;
+
+    /* Data is read only after the head index */
+    __DMB();
+
+    len = available < size ? available : size;
+    for (uint16_t i = 0; i < len; i++)
+        pData[i] = ring->data[(tail + i) & (CH9141_RX_RING_SIZE - 1)];
+
+    /* Data is read before the space is released */
+    __DMB();
+    ring->tail = tail + len;
+
+    return len;
+}
+
+/**
+ * @brief Internal function used to move the data received by DMA to the target ring buffer. Called with the reception
+ * interrupts masked or from them
+ * @param pos DMA position within the circular buffer
+ */
+static void Rx_Drain(uint16_t pos)
+{
+    if (pos > rxDMAPos)
+        Ring_Put(rxTarget, &rxDMA[rxDMAPos], pos - rxDMAPos);
+    else if (pos < rxDMAPos)
+    {
+        Ring_Put(rxTarget, &rxDMA[rxDMAPos], sizeof(rxDMA) - rxDMAPos);
+        Ring_Put(rxTarget, rxDMA, pos);
+    }
+    rxDMAPos = (pos == sizeof(rxDMA)) ? 0 : pos;
+}
+
+/**
+ * @brief Internal function used to direct the reception to another ring buffer. Everything received so far goes to
+ * the current one
+ * @param ring pointer to the new target ring buffer
+ */
+static void Rx_Switch(ch9141_Ring_t *ring)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    Rx_Drain(sizeof(rxDMA) - __HAL_DMA_GET_COUNTER(huart4.hdmarx));
+    rxTarget = ring;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Internal function used to count and clear the handle error left by the arbiter session
+ * @param ble pointer to the device handle
+ */
+static void Arbiter_ErrorTake(ch9141_t *ble)
+{
+    if (ble->error == CH9141_ERR_NONE)
+        return;
+
+    atStats.errors++;
+    atStats.lastError = ble->error;
+    ble->error = CH9141_ERR_NONE;
+}
+
+/**
+ * @brief Internal function used to receive the message from the ring buffer
+ * @param pDataRx pointer to the buffer where data will be saved
+ * @param size number of bytes to read
+ * @param rxLen pointer to variable to keep the number of bytes actually received
+ * @param response `true` to complete on AT response terminator, `false` to complete on idle line
+ * @return Status of the data transfer request operation
+ */
+static ch9141_ErrorStatus_t Ring_Receive(char *pDataRx, uint16_t size, uint16_t *rxLen, bool response)
+{
+    uint32_t start = HAL_GetTick();
+    uint32_t last = start;
+    uint16_t len = 0;
+    uint16_t n;
+
+    while ((len < size) && (HAL_GetTick() - start < CH9141_RX_TIMEOUT))
+    {
+        n = Ring_Read(atSession ? &rxAtRing : &rxRing, &pDataRx[len], size - len);
+        if (n != 0)
+        {
+            len += n;
+            last = HAL_GetTick();
+        }
+
+        if (response ? CH9141_ResponseIsComplete(pDataRx, len)
+                     : ((len != 0) && (HAL_GetTick() - last >= CH9141_RX_IDLE_GAP)))
+            break;
+    }
+
+    if (len < size)
+        pDataRx[len] = '\0';
+    if (rxLen != NULL)
+        *rxLen = len;
+
+    return len != 0 ? CH9141_ERROR_STATUS_SUCCESS : CH9141_ERROR_STATUS_ERROR;
+}
+
+/**
+ * @brief Internal function used to start DMA transfer of the next queued descriptor. Called with the transfer complete
+ * interrupt masked or from it. Nothing is started while the arbiter pauses the queue
+ */
+static void Tx_Next(void)
+{
+    while ((txTail != txHead) && !txPaused)
+    {
+        ch9141_TxDesc_t *desc = &txQueue[txTail & (CH9141_TX_QUEUE_SIZE - 1)];
+
+        txBusy = true;
+        if (HAL_UART_Transmit_DMA(&huart4, desc->pData, desc->size) == HAL_OK)
+            return;
+
+        /* Transfer cannot be started: return the buffer to the owner */
+        txTail++;
+        if (desc->done != NULL)
+            desc->done(desc->pData, desc->size, desc->context, false);
+    }
+    txBusy = false;
+}
@@ -3,11 +3,51 @@
 #include "ch9141.h"
 #include "usart.h"
 
+/* Transmit completion callback. `pData` buffer is returned to the owner, `ok` is `false` if the transfer failed */
+typedef void (*ch9141_TxDone_fp)(void const *pData, uint16_t size, void *context, bool ok);
+
 ch9141_ErrorStatus_t CH9141_UART_Receive(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
+ch9141_ErrorStatus_t CH9141_UART_ReceiveResponse(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
+ch9141_ErrorStatus_t CH9141_UART_ReceivePoll(void *handle, char *pDataRx, uint16_t size, uint16_t *rxLen);
 ch9141_ErrorStatus_t CH9141_UART_Transmit(void *handle, char const *pDataTx, uint16_t size);
+ch9141_ErrorStatus_t CH9141_UART_BaudSet(void *handle, uint32_t baudRate);
 void CH9141_Delay(uint32_t ms);
+uint32_t CH9141_Tick(void);
 void CH9141_Pin_Mode1(ch9141_PinState_t newState);
 void CH9141_Pin_Reset1(ch9141_PinState_t newState);
 void CH9141_Pin_Reload1(ch9141_PinState_t newState);
 void CH9141_Pin_Sleep1(ch9141_PinState_t newState);
-ErrorStatus CH9141_SetUp(ch9141_t *ble);
\ No newline at end of file
+ErrorStatus CH9141_SetUp(ch9141_t *ble);
+
+/* UART4 background reception: circular DMA feeds the ring buffer. Driver receive functions read from the ring while it
+ * is running */
+ErrorStatus CH9141_RxStart(void);
+void CH9141_RxStop(void);
+uint16_t CH9141_Available(void);
+uint16_t CH9141_Read(char *pData, uint16_t size);
+uint32_t CH9141_RxDropped(void);
+
+/* UART4 transmit queue: buffers are sent by DMA back-to-back without copying. The buffer must stay intact until `done`
+ * is called (from interrupt context). Driver transmit function waits for the queue to drain */
+ErrorStatus CH9141_TxQueue(void const *pData, uint16_t size, ch9141_TxDone_fp done, void *context);
+uint16_t CH9141_TxPending(void);
+
+/* UART4 arbiter: queued AT jobs are run by the driver while the transmit queue is paused at the frame boundary. Data
+ * received before the first AT command stays for CH9141_Read(), queued frames are sent after the session. Jobs are
+ * submitted and processed from the main loop. Job reads its result from `ble->error`, the error is cleared after the
+ * job, so one failure does not affect the next ones */
+typedef void (*ch9141_AtJob_fp)(ch9141_t *ble, void *context);
+
+typedef struct ch9141_ArbiterStats_s {
+    uint32_t sessions; // Number of AT sessions run
+    uint32_t jobs; // Number of jobs run
+    uint32_t errors; // Number of failed jobs and mode switches
+    ch9141_Error_t lastError;
+    uint32_t pauseLast; // [ms]. Transmit queue pause of the last session
+    uint32_t pauseMax; // [ms]
+    uint32_t pauseTotal; // [ms]
+} ch9141_ArbiterStats_t;
+
+ErrorStatus CH9141_AtSubmit(ch9141_AtJob_fp job, void *context);
+void CH9141_ArbiterProcess(ch9141_t *ble);
+void CH9141_ArbiterStatsGet(ch9141_ArbiterStats_t *stats);
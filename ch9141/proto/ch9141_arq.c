@@ -0,0 +1,299 @@
+#include "ch9141_arq.h"
+
+#define ARQ_SLOT(arq, seq) (&(arq)->slots[(uint8_t) (seq) & (CH9141_ARQ_WINDOW_MAX - 1)])
+
+static void Arq_FrameReceived(uint8_t const *pData, uint16_t size, void *context);
+static void Arq_Acked(ch9141_Arq_t *arq, uint8_t ack);
+static void Arq_Flush(ch9141_Arq_t *arq);
+static ch9141_ErrorStatus_t Arq_Control(ch9141_Arq_t *arq, ch9141_ArqType_t type, uint8_t seq);
+static void Arq_Sync(ch9141_Arq_t *arq, uint8_t seq);
+
+ch9141_ErrorStatus_t CH9141_ARQ_Init(ch9141_Arq_t *arq)
+{
+    if (arq == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Check arguments */
+    if ((arq->transmit == NULL) || (arq->tick == NULL) || (arq->timeout == 0) ||
+        (arq->window > CH9141_ARQ_WINDOW_MAX))
+        return CH9141_ERROR_STATUS_ERROR;
+
+    if (arq->window == 0)
+        arq->window = CH9141_ARQ_WINDOW_MAX;
+    if (arq->epoch == 0)
+        arq->epoch = (uint8_t) (arq->tick() % UINT8_MAX + 1);
+    memset(&arq->decoder, 0, sizeof(ch9141_Arq_t) - offsetof(ch9141_Arq_t, decoder));
+    CH9141_FRAME_DecoderInit(&arq->decoder, arq->rxBuf, sizeof(arq->rxBuf), Arq_FrameReceived, arq);
+    arq->restarted = true;
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+ch9141_ErrorStatus_t CH9141_ARQ_Send(ch9141_Arq_t *arq, void const *pData, uint16_t size)
+{
+    ch9141_ArqSlot_t *slot;
+    uint8_t header[CH9141_ARQ_HEADER_SIZE];
+
+    if (arq == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Check arguments */
+    if (((pData == NULL) && (size != 0)) || (size > CH9141_ARQ_PAYLOAD_MAX))
+        return CH9141_ERROR_STATUS_ERROR;
+
+    if (CH9141_ARQ_Free(arq) == 0)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Frame is encoded once and kept in the pool until acknowledged */
+    slot = ARQ_SLOT(arq, arq->next);
+    header[0] = CH9141_ARQ_TYPE_DATA;
+    header[1] = arq->next;
+    slot->len = CH9141_FRAME_EncodeHeader(header, sizeof(header), pData, size, slot->frame, sizeof(slot->frame));
+    slot->tries = 0;
+    slot->sent = false;
+    if (arq->next == arq->base)
+        arq->timerStart = arq->tick();
+    arq->next++;
+    arq->stats.sent++;
+
+    Arq_Flush(arq);
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+void CH9141_ARQ_Receive(ch9141_Arq_t *arq, void const *pData, uint16_t size)
+{
+    if (arq == NULL)
+        return;
+
+    CH9141_FRAME_Decode(&arq->decoder, pData, size);
+
+    /* Single cumulative acknowledgment for the whole chunk */
+    if (arq->ackPending && (Arq_Control(arq, CH9141_ARQ_TYPE_ACK, arq->expected) == CH9141_ERROR_STATUS_SUCCESS))
+        arq->ackPending = false;
+}
+
+void CH9141_ARQ_Process(ch9141_Arq_t *arq)
+{
+    uint32_t now;
+
+    if (arq == NULL)
+        return;
+
+    if (arq->ackPending && (Arq_Control(arq, CH9141_ARQ_TYPE_ACK, arq->expected) == CH9141_ERROR_STATUS_SUCCESS))
+        arq->ackPending = false;
+
+    if (arq->stalled || (CH9141_ARQ_InFlight(arq) == 0))
+        return;
+
+    /* Go-back-N: everything in flight is sent again */
+    now = arq->tick();
+    if (now - arq->timerStart >= arq->timeout)
+    {
+        arq->stats.timeouts++;
+        arq->timerStart = now;
+        if ((arq->retriesMax != 0) && (++arq->retries > arq->retriesMax))
+        {
+            arq->stalled = true;
+            return;
+        }
+        for (uint8_t seq = arq->base; seq != arq->next; seq++)
+            ARQ_SLOT(arq, seq)->sent = false;
+
+        /* Reset could be lost as well */
+        if (arq->restarted)
+            arq->syncPending = true;
+    }
+
+    Arq_Flush(arq);
+}
+
+void CH9141_ARQ_Resume(ch9141_Arq_t *arq)
+{
+    if (arq == NULL)
+        return;
+
+    CH9141_FRAME_DecoderReset(&arq->decoder);
+    arq->stalled = false;
+    arq->retries = 0;
+    arq->timerStart = arq->tick();
+    for (uint8_t seq = arq->base; seq != arq->next; seq++)
+        ARQ_SLOT(arq, seq)->sent = false;
+    arq->syncPending = true;
+    arq->ackPending = true;
+
+    Arq_Flush(arq);
+    if (arq->ackPending && (Arq_Control(arq, CH9141_ARQ_TYPE_ACK, arq->expected) == CH9141_ERROR_STATUS_SUCCESS))
+        arq->ackPending = false;
+}
+
+uint8_t CH9141_ARQ_Free(ch9141_Arq_t const *arq)
+{
+    if ((arq == NULL) || arq->stalled)
+        return 0;
+
+    return arq->window - CH9141_ARQ_InFlight(arq);
+}
+
+uint8_t CH9141_ARQ_InFlight(ch9141_Arq_t const *arq)
+{
+    if (arq == NULL)
+        return 0;
+
+    return (uint8_t) (arq->next - arq->base);
+}
+
+/**
+ * @brief Internal function used to handle the decoded packet
+ * @param pData pointer to the packet
+ * @param size packet length
+ * @param context pointer to the transport
+ */
+static void Arq_FrameReceived(uint8_t const *pData, uint16_t size, void *context)
+{
+    ch9141_Arq_t *arq = context;
+    uint8_t seq;
+
+    if (size < CH9141_ARQ_HEADER_SIZE)
+        return;
+
+    seq = pData[1];
+    switch (pData[0])
+    {
+    case CH9141_ARQ_TYPE_DATA:
+        arq->ackPending = true;
+        if (seq != arq->expected)
+        {
+            /* Behind the expected one: acknowledgment was lost */
+            if ((uint8_t) (arq->expected - seq) <= CH9141_ARQ_WINDOW_MAX)
+                arq->stats.duplicates++;
+            else
+                arq->stats.outOfOrder++;
+            break;
+        }
+        arq->expected++;
+        arq->stats.delivered++;
+        if (arq->received != NULL)
+            arq->received(pData + CH9141_ARQ_HEADER_SIZE, size - CH9141_ARQ_HEADER_SIZE, arq->context);
+        break;
+
+    case CH9141_ARQ_TYPE_ACK:
+        Arq_Acked(arq, seq);
+        break;
+
+    case CH9141_ARQ_TYPE_SYNC:
+        Arq_Sync(arq, seq);
+        break;
+
+    case CH9141_ARQ_TYPE_RESET:
+        if (size != CH9141_ARQ_HEADER_SIZE + 1)
+            break;
+
+        /* Reset of the new epoch rewinds, the repeated one may follow the messages it already started */
+        if (pData[CH9141_ARQ_HEADER_SIZE] != arq->peerEpoch)
+        {
+            arq->peerEpoch = pData[CH9141_ARQ_HEADER_SIZE];
+            arq->expected = seq;
+            arq->ackPending = true;
+        }
+        else
+            Arq_Sync(arq, seq);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Internal function used to synchronize the receiver with the oldest unacknowledged message of the sender
+ * @param arq pointer to the transport
+ * @param seq oldest unacknowledged sequence number of the sender
+ */
+static void Arq_Sync(ch9141_Arq_t *arq, uint8_t seq)
+{
+    /* Ahead of the sender within the window means delivered messages with lost acknowledgments */
+    if ((uint8_t) (arq->expected - seq) > CH9141_ARQ_WINDOW_MAX)
+        arq->expected = seq;
+    arq->ackPending = true;
+}
+
+/**
+ * @brief Internal function used to release the pool slots on cumulative acknowledgment
+ * @param arq pointer to the transport
+ * @param ack next sequence number expected by the peer
+ */
+static void Arq_Acked(ch9141_Arq_t *arq, uint8_t ack)
+{
+    uint8_t acked = (uint8_t) (ack - arq->base);
+
+    /* Duplicate or stale acknowledgment */
+    if ((acked == 0) || (acked > CH9141_ARQ_InFlight(arq)))
+        return;
+
+    arq->base = ack;
+    arq->stats.acked += acked;
+    arq->retries = 0;
+    arq->restarted = false;
+    arq->timerStart = arq->tick();
+}
+
+/**
+ * @brief Internal function used to transmit pending synchronization and data frames in order
+ * @param arq pointer to the transport
+ */
+static void Arq_Flush(ch9141_Arq_t *arq)
+{
+    ch9141_ArqSlot_t *slot;
+
+    if (arq->syncPending)
+    {
+        if (Arq_Control(arq, arq->restarted ? CH9141_ARQ_TYPE_RESET : CH9141_ARQ_TYPE_SYNC, arq->base) !=
+            CH9141_ERROR_STATUS_SUCCESS)
+            return;
+        arq->syncPending = false;
+    }
+
+    for (uint8_t seq = arq->base; seq != arq->next; seq++)
+    {
+        slot = ARQ_SLOT(arq, seq);
+        if (slot->sent)
+            continue;
+
+        if (arq->transmit(slot->frame, slot->len, arq->context) != CH9141_ERROR_STATUS_SUCCESS)
+        {
+            arq->stats.transmitErrors++;
+            return;
+        }
+        if (slot->tries++ != 0)
+            arq->stats.retransmits++;
+        slot->sent = true;
+    }
+}
+
+/**
+ * @brief Internal function used to transmit the control frame
+ * @param arq pointer to the transport
+ * @param type packet type
+ * @param seq sequence number
+ * @return Status of the operation
+ */
+static ch9141_ErrorStatus_t Arq_Control(ch9141_Arq_t *arq, ch9141_ArqType_t type, uint8_t seq)
+{
+    uint8_t header[CH9141_ARQ_HEADER_SIZE] = {type, seq};
+    uint8_t *pFrame = arq->ctrl[arq->ctrlNext];
+    uint16_t len;
+
+    if (type == CH9141_ARQ_TYPE_RESET)
+        len = CH9141_FRAME_EncodeHeader(header, sizeof(header), &arq->epoch, 1, pFrame, CH9141_ARQ_CTRL_FRAME_MAX);
+    else
+        len = CH9141_FRAME_EncodeHeader(header, sizeof(header), NULL, 0, pFrame, CH9141_ARQ_CTRL_FRAME_MAX);
+    if (arq->transmit(pFrame, len, arq->context) != CH9141_ERROR_STATUS_SUCCESS)
+    {
+        arq->stats.transmitErrors++;
+        return CH9141_ERROR_STATUS_ERROR;
+    }
+    arq->ctrlNext = (uint8_t) ((arq->ctrlNext + 1) % CH9141_ARQ_ACK_NUM);
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "ch9141.h"
+#include "ch9141_frame.h"
+
+/**
+ * @file ch9141_arq.h
+ * @brief Reliable delivery over the transparent mode stream. Messages are numbered, up to `window` of them are kept in
+ * flight and acknowledged cumulatively by the peer. Unacknowledged messages are retransmitted from the fixed pool on
+ * timeout (go-back-N) and after the reconnection, receiver delivers them once and in order
+ */
+
+#ifndef CH9141_ARQ_PAYLOAD_MAX
+#define CH9141_ARQ_PAYLOAD_MAX 128 // Max message length
+#endif
+#ifndef CH9141_ARQ_WINDOW_MAX
+#define CH9141_ARQ_WINDOW_MAX 8 // Number of pool slots. Must be power of 2, not more than 64
+#endif
+#ifndef CH9141_ARQ_ACK_NUM
+#define CH9141_ARQ_ACK_NUM 8 // Number of control frame buffers reused in turn. Not less than the transmit queue depth
+#endif
+
+#define CH9141_ARQ_HEADER_SIZE 2 // Packet type and sequence number
+#define CH9141_ARQ_FRAME_MAX CH9141_FRAME_ENCODED_MAX(CH9141_ARQ_PAYLOAD_MAX + CH9141_ARQ_HEADER_SIZE)
+#define CH9141_ARQ_CTRL_FRAME_MAX CH9141_FRAME_ENCODED_MAX(CH9141_ARQ_HEADER_SIZE + 1) // Reset carries the epoch
+
+typedef enum ch9141_ArqType_e {
+    CH9141_ARQ_TYPE_DATA = 0x01, // Sequence number of the message, then the message
+    CH9141_ARQ_TYPE_ACK, // Next sequence number expected by the receiver
+    CH9141_ARQ_TYPE_SYNC, // Oldest unacknowledged sequence number of the sender
+    CH9141_ARQ_TYPE_RESET // Sequence number the restarted sender begins with, then its epoch
+} ch9141_ArqType_t;
+
+/**
+ * @brief Transmits the encoded frame
+ * @param pFrame pointer to the frame. Data frames stay unchanged until acknowledged, control frames until
+ * `CH9141_ARQ_ACK_NUM` more control frames are sent
+ * @param size frame length
+ * @param context user context of the transport
+ * @return Status of the data transfer request operation
+ */
+typedef ch9141_ErrorStatus_t (*ch9141_ArqTransmit_fp)(uint8_t const *pFrame, uint16_t size, void *context);
+
+/**
+ * @brief Message delivery callback
+ * @param pData pointer to the message, valid until the callback returns
+ * @param size message length
+ * @param context user context of the transport
+ */
+typedef void (*ch9141_ArqReceived_fp)(uint8_t const *pData, uint16_t size, void *context);
+
+/* Pool slot of the message in flight */
+typedef struct ch9141_ArqSlot_s {
+    uint8_t frame[CH9141_ARQ_FRAME_MAX]; // Encoded data frame
+    uint16_t len; // Frame length
+    uint8_t tries; // Number of times the frame is handed to the transmit function
+    bool sent; // Frame is handed to the transmit function since the last (re)transmission request
+} ch9141_ArqSlot_t;
+
+typedef struct ch9141_Arq_s {
+    /* Set by the user before CH9141_ARQ_Init() */
+    ch9141_ArqTransmit_fp transmit;
+    ch9141_ArqReceived_fp received;
+    ch9141_Tick_fp tick;
+    void *context; // Optional user context passed to `transmit` and `received`
+    uint8_t window; // Max number of messages in flight, 1..CH9141_ARQ_WINDOW_MAX. 0 means CH9141_ARQ_WINDOW_MAX
+    uint16_t timeout; // [ms]. Retransmission timeout, should exceed the round trip time
+    uint8_t retriesMax; // Number of timeouts in a row after which the link is stalled. 0 means no limit
+    uint8_t epoch; // Sender session id, should differ between restarts, e.g. from the RNG. 0 means taken from the tick
+
+    ch9141_FrameDecoder_t decoder;
+    uint8_t rxBuf[CH9141_ARQ_PAYLOAD_MAX + CH9141_ARQ_HEADER_SIZE + CH9141_FRAME_CRC_SIZE];
+    ch9141_ArqSlot_t slots[CH9141_ARQ_WINDOW_MAX]; // Indexed by the sequence number
+    uint8_t ctrl[CH9141_ARQ_ACK_NUM][CH9141_ARQ_CTRL_FRAME_MAX];
+    uint8_t ctrlNext; // Next control frame buffer
+    uint8_t base; // Oldest unacknowledged sequence number
+    uint8_t next; // Sequence number of the next message
+    uint8_t expected; // Sequence number of the next message to be delivered
+    uint8_t peerEpoch; // Epoch of the last reset received, 0 if none
+    uint8_t retries; // Number of timeouts in a row
+    uint32_t timerStart; // [ms]. Retransmission timer of the oldest message in flight
+    bool ackPending; // Acknowledgment to be sent
+    bool syncPending; // Synchronization to be sent
+    bool restarted; // No message is acknowledged since the initialization, peer receiver is synchronized by reset
+    bool stalled; // `retriesMax` is exceeded, retransmission is suspended until CH9141_ARQ_Resume()
+
+    struct {
+        uint32_t sent; // Number of messages accepted for transmission
+        uint32_t acked; // Number of messages acknowledged by the peer
+        uint32_t retransmits; // Number of data frames sent again
+        uint32_t timeouts; // Number of retransmission timer expirations
+        uint32_t delivered; // Number of messages delivered to the user
+        uint32_t duplicates; // Number of received data frames already delivered
+        uint32_t outOfOrder; // Number of received data frames dropped as ahead of the expected one
+        uint32_t transmitErrors; // Number of frames refused by the transmit function
+    } stats;
+} ch9141_Arq_t;
+
+/**
+ * @brief Initializes the transport state. Both peers start from sequence number 0, the peer receiver is rewound by the
+ * reset of the new epoch
+ * @param arq pointer to the transport
+ * @return Status of the operation
+ */
+ch9141_ErrorStatus_t CH9141_ARQ_Init(ch9141_Arq_t *arq);
+
+/**
+ * @brief Takes the message for the reliable delivery and transmits it
+ * @param arq pointer to the transport
+ * @param pData pointer to the message, copied into the pool
+ * @param size message length, up to CH9141_ARQ_PAYLOAD_MAX
+ * @return Status of the operation. Error if the window is full or the link is stalled
+ */
+ch9141_ErrorStatus_t CH9141_ARQ_Send(ch9141_Arq_t *arq, void const *pData, uint16_t size);
+
+/**
+ * @brief Feeds the transport with the received stream, delivers the messages and acknowledges them
+ * @param arq pointer to the transport
+ * @param pData pointer to the received data, any part of the stream
+ * @param size number of bytes
+ */
+void CH9141_ARQ_Receive(ch9141_Arq_t *arq, void const *pData, uint16_t size);
+
+/**
+ * @brief Runs retransmission timer and sends frames refused by the transmit function earlier
+ * @param arq pointer to the transport
+ * @note Must be called periodically, e.g. from the main loop
+ */
+void CH9141_ARQ_Process(ch9141_Arq_t *arq);
+
+/**
+ * @brief Resumes the transfer after the reconnection. Peer is synchronized and the messages in flight are sent again
+ * @param arq pointer to the transport
+ * @note Must be called on each connection, the first one included. Peer receiver skips to the oldest unacknowledged
+ * message, so nothing is delivered twice
+ */
+void CH9141_ARQ_Resume(ch9141_Arq_t *arq);
+
+/**
+ * @brief Returns the number of messages that can be sent now
+ * @param arq pointer to the transport
+ * @return Number of free window slots
+ */
+uint8_t CH9141_ARQ_Free(ch9141_Arq_t const *arq);
+
+/**
+ * @brief Returns the number of unacknowledged messages
+ * @param arq pointer to the transport
+ * @return Number of messages in flight
+ */
+uint8_t CH9141_ARQ_InFlight(ch9141_Arq_t const *arq);
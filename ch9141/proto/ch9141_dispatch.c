@@ -0,0 +1,306 @@
+#include "ch9141_dispatch.h"
+
+#define DISPATCH_WINDOW_MASK ((uint32_t) (((uint64_t) 1 << (8 * CH9141_DISPATCH_VERB_LEN)) - 1))
+
+static uint32_t Dispatch_Key(char const *verb);
+static uint32_t Dispatch_Hash(uint32_t key, uint32_t seed);
+static uint16_t Dispatch_Slot(uint32_t key, uint16_t disp);
+static ch9141_Verb_t const *Dispatch_Lookup(ch9141_Dispatcher_t const *dispatcher, uint32_t key);
+static bool Dispatch_Place(ch9141_Dispatcher_t *dispatcher, uint16_t bucket, uint16_t disp);
+static void Dispatch_Argument(ch9141_Dispatcher_t *dispatcher, char c);
+static void Dispatch_Verb(ch9141_Dispatcher_t *dispatcher, char c);
+
+ch9141_ErrorStatus_t CH9141_DISPATCH_Init(ch9141_Dispatcher_t *dispatcher)
+{
+    uint16_t bucketSize[CH9141_DISPATCH_BUCKETS] = {0};
+    uint16_t sizeMax = 0;
+    uint32_t key;
+    uint16_t disp;
+
+    if (dispatcher == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Check arguments */
+    if ((dispatcher->verbs == NULL) || (dispatcher->verbNum == 0) ||
+        (dispatcher->verbNum > CH9141_DISPATCH_SLOTS / 2))
+        return CH9141_ERROR_STATUS_ERROR;
+    for (uint16_t i = 0; i < dispatcher->verbNum; i++)
+    {
+        if ((dispatcher->verbs[i].verb == NULL) || (dispatcher->verbs[i].handler == NULL) ||
+            (strlen(dispatcher->verbs[i].verb) != CH9141_DISPATCH_VERB_LEN) ||
+            ((dispatcher->verbs[i].schema != NULL) &&
+             ((strlen(dispatcher->verbs[i].schema) > CH9141_DISPATCH_ARGS_MAX) ||
+              (strspn(dispatcher->verbs[i].schema, "ui") != strlen(dispatcher->verbs[i].schema)))))
+            return CH9141_ERROR_STATUS_ERROR;
+
+        for (uint16_t j = 0; j < i; j++)
+        {
+            if (strcmp(dispatcher->verbs[i].verb, dispatcher->verbs[j].verb) == 0)
+                return CH9141_ERROR_STATUS_ERROR;
+        }
+
+        key = Dispatch_Key(dispatcher->verbs[i].verb);
+        bucketSize[Dispatch_Hash(key, 0) % CH9141_DISPATCH_BUCKETS]++;
+    }
+
+    memset(&dispatcher->slots, 0, sizeof(ch9141_Dispatcher_t) - offsetof(ch9141_Dispatcher_t, slots));
+    for (uint16_t b = 0; b < CH9141_DISPATCH_BUCKETS; b++)
+    {
+        if (bucketSize[b] > sizeMax)
+            sizeMax = bucketSize[b];
+    }
+
+    /* Hash and displace: the largest buckets are placed first, while the table is empty */
+    for (uint16_t size = sizeMax; size != 0; size--)
+    {
+        for (uint16_t b = 0; b < CH9141_DISPATCH_BUCKETS; b++)
+        {
+            if (bucketSize[b] != size)
+                continue;
+
+            for (disp = 0; disp < 4 * CH9141_DISPATCH_SLOTS; disp++)
+            {
+                if (Dispatch_Place(dispatcher, b, disp))
+                    break;
+            }
+            if (disp == 4 * CH9141_DISPATCH_SLOTS)
+                return CH9141_ERROR_STATUS_ERROR;
+            dispatcher->disp[b] = disp;
+        }
+    }
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+void CH9141_DISPATCH_Feed(ch9141_Dispatcher_t *dispatcher, void const *pData, uint16_t size)
+{
+    char const *pChar = pData;
+
+    if ((dispatcher == NULL) || (pData == NULL))
+        return;
+
+    while (size--)
+    {
+        if (dispatcher->pending != NULL)
+            Dispatch_Argument(dispatcher, *pChar);
+        else
+            Dispatch_Verb(dispatcher, *pChar);
+        pChar++;
+    }
+}
+
+ch9141_Verb_t const *CH9141_DISPATCH_Find(ch9141_Dispatcher_t const *dispatcher, char const *verb)
+{
+    char buf[CH9141_DISPATCH_VERB_LEN + 1] = {0};
+
+    if ((dispatcher == NULL) || (verb == NULL))
+        return NULL;
+
+    memcpy(buf, verb, CH9141_DISPATCH_VERB_LEN);
+    if (strlen(buf) != CH9141_DISPATCH_VERB_LEN)
+        return NULL;
+
+    return Dispatch_Lookup(dispatcher, Dispatch_Key(buf));
+}
+
+/**
+ * @brief Internal function used to pack the verb characters
+ * @param verb pointer to the null-terminated verb
+ * @return Verb characters, the last one in the low byte
+ */
+static uint32_t Dispatch_Key(char const *verb)
+{
+    uint32_t key = 0;
+
+    for (uint8_t i = 0; i < CH9141_DISPATCH_VERB_LEN; i++)
+        key = (key << 8) | (uint8_t) verb[i];
+
+    return key;
+}
+
+/**
+ * @brief Internal function used to hash the packed verb
+ * @param key packed verb
+ * @param seed selects one of the independent hash functions
+ * @return Hash value
+ */
+static uint32_t Dispatch_Hash(uint32_t key, uint32_t seed)
+{
+    key ^= seed * 0x9E3779B9u;
+    key ^= key >> 16;
+    key *= 0x85EBCA6Bu;
+    key ^= key >> 13;
+    key *= 0xC2B2AE35u;
+    key ^= key >> 16;
+
+    return key;
+}
+
+/**
+ * @brief Internal function used to find the slot of the key within the table
+ * @param key packed verb
+ * @param disp displacement of the key bucket
+ * @return Slot index
+ */
+static uint16_t Dispatch_Slot(uint32_t key, uint16_t disp)
+{
+    uint32_t h1 = Dispatch_Hash(key, 1);
+    uint32_t h2 = Dispatch_Hash(key, 2) | 1; // Odd step visits all the slots
+
+    return (uint16_t) ((h1 + disp * h2) & (CH9141_DISPATCH_SLOTS - 1));
+}
+
+/**
+ * @brief Internal function used to look the packed verb up
+ * @param dispatcher pointer to the dispatcher
+ * @param key packed verb
+ * @return Pointer to the verb table entry. NULL if not found
+ */
+static ch9141_Verb_t const *Dispatch_Lookup(ch9141_Dispatcher_t const *dispatcher, uint32_t key)
+{
+    uint16_t disp = dispatcher->disp[Dispatch_Hash(key, 0) % CH9141_DISPATCH_BUCKETS];
+    uint16_t slot = dispatcher->slots[Dispatch_Slot(key, disp)];
+    ch9141_Verb_t const *verb;
+
+    if (slot == 0)
+        return NULL;
+
+    /* Any key lands on some slot, the verb itself tells */
+    verb = &dispatcher->verbs[slot - 1];
+    if (Dispatch_Key(verb->verb) != key)
+        return NULL;
+
+    return verb;
+}
+
+/**
+ * @brief Internal function used to place all the verbs of the bucket with the displacement
+ * @param dispatcher pointer to the dispatcher
+ * @param bucket bucket index
+ * @param disp displacement to try
+ * @return `true` if the bucket verbs took free distinct slots, the table is left unchanged otherwise
+ */
+static bool Dispatch_Place(ch9141_Dispatcher_t *dispatcher, uint16_t bucket, uint16_t disp)
+{
+    uint32_t key;
+    uint16_t slot;
+
+    for (uint16_t i = 0; i < dispatcher->verbNum; i++)
+    {
+        key = Dispatch_Key(dispatcher->verbs[i].verb);
+        if (Dispatch_Hash(key, 0) % CH9141_DISPATCH_BUCKETS != bucket)
+            continue;
+
+        slot = Dispatch_Slot(key, disp);
+        if (dispatcher->slots[slot] == 0)
+        {
+            dispatcher->slots[slot] = i + 1;
+            continue;
+        }
+
+        /* Roll the bucket verbs placed so far back */
+        for (uint16_t j = 0; j < i; j++)
+        {
+            key = Dispatch_Key(dispatcher->verbs[j].verb);
+            if (Dispatch_Hash(key, 0) % CH9141_DISPATCH_BUCKETS == bucket)
+                dispatcher->slots[Dispatch_Slot(key, disp)] = 0;
+        }
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Internal function used to shift the character into the verb window and dispatch the complete verb
+ * @param dispatcher pointer to the dispatcher
+ * @param c received character
+ */
+static void Dispatch_Verb(ch9141_Dispatcher_t *dispatcher, char c)
+{
+    ch9141_Verb_t const *verb;
+
+    dispatcher->window = ((dispatcher->window << 8) | (uint8_t) c) & DISPATCH_WINDOW_MASK;
+    if (dispatcher->filled < CH9141_DISPATCH_VERB_LEN)
+        dispatcher->filled++;
+    if (dispatcher->filled < CH9141_DISPATCH_VERB_LEN)
+        return;
+
+    verb = Dispatch_Lookup(dispatcher, dispatcher->window);
+    if (verb == NULL)
+        return;
+
+    /* Verb characters are not reused by the next one */
+    dispatcher->filled = 0;
+    if ((verb->schema == NULL) || (verb->schema[0] == '\0'))
+    {
+        dispatcher->stats.dispatched++;
+        verb->handler(NULL, 0, dispatcher->context);
+        return;
+    }
+
+    dispatcher->pending = verb;
+    dispatcher->argc = 0;
+    dispatcher->args[0] = 0;
+    dispatcher->digits = false;
+    dispatcher->negative = false;
+}
+
+/**
+ * @brief Internal function used to parse the argument character of the pending verb
+ * @param dispatcher pointer to the dispatcher
+ * @param c received character
+ * @note Malformed verb, including the argument out of `int32_t` range, is dropped. The character is scanned for the
+ * next verb then
+ */
+static void Dispatch_Argument(ch9141_Dispatcher_t *dispatcher, char c)
+{
+    ch9141_Verb_t const *verb = dispatcher->pending;
+    uint8_t argNum = (uint8_t) strlen(verb->schema);
+    int32_t *arg = &dispatcher->args[dispatcher->argc];
+    int32_t digit = c - '0';
+
+    if ((c >= '0') && (c <= '9') && (dispatcher->argc < argNum))
+    {
+        /* Overflow is checked before the accumulation */
+        if (dispatcher->negative ? (*arg >= (INT32_MIN + digit) / 10) : (*arg <= (INT32_MAX - digit) / 10))
+        {
+            *arg = *arg * 10 + (dispatcher->negative ? -digit : digit);
+            dispatcher->digits = true;
+            return;
+        }
+    }
+
+    if ((c == '-') && (dispatcher->argc < argNum) && (verb->schema[dispatcher->argc] == 'i') &&
+        !dispatcher->digits && !dispatcher->negative)
+    {
+        dispatcher->negative = true;
+        return;
+    }
+
+    if ((c == ' ') && !dispatcher->digits && !dispatcher->negative)
+        return;
+
+    if (dispatcher->digits && ((c == ',') || (c == ';') || (c == '\r') || (c == '\n')))
+    {
+        dispatcher->argc++;
+        dispatcher->digits = false;
+        dispatcher->negative = false;
+        if (dispatcher->argc < CH9141_DISPATCH_ARGS_MAX)
+            dispatcher->args[dispatcher->argc] = 0;
+
+        if ((c == ',') && (dispatcher->argc < argNum))
+            return;
+        if ((c != ',') && (dispatcher->argc == argNum))
+        {
+            dispatcher->pending = NULL;
+            dispatcher->stats.dispatched++;
+            verb->handler(dispatcher->args, dispatcher->argc, dispatcher->context);
+            return;
+        }
+    }
+
+    dispatcher->pending = NULL;
+    dispatcher->stats.argErrors++;
+    Dispatch_Verb(dispatcher, c);
+}
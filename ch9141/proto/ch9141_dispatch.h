@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ch9141.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @file ch9141_dispatch.h
+ * @brief Command dispatcher for the transparent mode stream. Verbs of `CH9141_DISPATCH_VERB_LEN` characters are
+ * recognized at any position of the stream by the last characters received, through the perfect hash built from the
+ * verb table once on init: each received character costs the same regardless of the number of verbs. Verbs with the
+ * argument schema take decimal arguments separated by `,` and terminated by `;`, CR or LF
+ */
+
+#define CH9141_DISPATCH_VERB_LEN 4 // Number of characters of each verb, up to 4
+#ifndef CH9141_DISPATCH_SLOTS
+#define CH9141_DISPATCH_SLOTS 256 // Hash table size. Must be power of 2, at least twice the number of verbs
+#endif
+#define CH9141_DISPATCH_BUCKETS (CH9141_DISPATCH_SLOTS / 4) // Number of displacement buckets
+#ifndef CH9141_DISPATCH_ARGS_MAX
+#define CH9141_DISPATCH_ARGS_MAX 4 // Max number of arguments
+#endif
+
+/**
+ * @brief Verb handler
+ * @param args parsed arguments, NULL if the verb has none
+ * @param argc number of arguments
+ * @param context user context of the dispatcher
+ */
+typedef void (*ch9141_VerbHandler_fp)(int32_t const *args, uint8_t argc, void *context);
+
+typedef struct ch9141_Verb_s {
+    char const *verb; // Exactly CH9141_DISPATCH_VERB_LEN characters
+    ch9141_VerbHandler_fp handler;
+    char const *schema; // Argument types: 'u' - unsigned up to INT32_MAX, 'i' - signed decimal. NULL or "" if none
+} ch9141_Verb_t;
+
+typedef struct ch9141_Dispatcher_s {
+    /* Set by the user before CH9141_DISPATCH_Init() */
+    ch9141_Verb_t const *verbs; // Verb table, must stay valid
+    uint16_t verbNum; // Number of verbs, up to CH9141_DISPATCH_SLOTS / 2
+    void *context; // Optional user context passed to the handlers
+
+    uint16_t slots[CH9141_DISPATCH_SLOTS]; // Verb index + 1, 0 if free
+    uint16_t disp[CH9141_DISPATCH_BUCKETS]; // Displacement of the bucket
+    uint32_t window; // Last received characters
+    uint8_t filled; // Number of characters in the window
+    ch9141_Verb_t const *pending; // Verb collecting its arguments
+    int32_t args[CH9141_DISPATCH_ARGS_MAX];
+    uint8_t argc; // Number of complete arguments
+    bool digits; // Current argument has digits
+    bool negative; // Current argument is negative
+
+    struct {
+        uint32_t dispatched; // Number of handler calls
+        uint32_t argErrors; // Number of verbs dropped due to malformed arguments
+    } stats;
+} ch9141_Dispatcher_t;
+
+/**
+ * @brief Builds the perfect hash of the verb table and resets the stream state
+ * @param dispatcher pointer to the dispatcher
+ * @return Status of the operation. Error on malformed or repeated verb, unknown argument type or too many verbs
+ */
+ch9141_ErrorStatus_t CH9141_DISPATCH_Init(ch9141_Dispatcher_t *dispatcher);
+
+/**
+ * @brief Feeds the dispatcher with the received stream, handlers are called as verbs complete
+ * @param dispatcher pointer to the dispatcher
+ * @param pData pointer to the received data, any part of the stream
+ * @param size number of bytes
+ */
+void CH9141_DISPATCH_Feed(ch9141_Dispatcher_t *dispatcher, void const *pData, uint16_t size);
+
+/**
+ * @brief Looks the verb up
+ * @param dispatcher pointer to the dispatcher
+ * @param verb pointer to CH9141_DISPATCH_VERB_LEN characters, not necessarily null-terminated
+ * @return Pointer to the verb table entry. NULL if not found
+ */
+ch9141_Verb_t const *CH9141_DISPATCH_Find(ch9141_Dispatcher_t const *dispatcher, char const *verb);
@@ -0,0 +1,198 @@
+#include "ch9141_frame.h"
+
+static void Decoder_Put(ch9141_FrameDecoder_t *decoder, uint8_t byte);
+static void Decoder_End(ch9141_FrameDecoder_t *decoder);
+
+uint16_t CH9141_FRAME_CRC16(uint16_t crc, void const *pData, uint16_t size)
+{
+    uint8_t const *pByte = pData;
+
+    if (pData == NULL)
+        return crc;
+
+    while (size--)
+    {
+        crc = (uint16_t) ((crc >> 8) | (crc << 8));
+        crc ^= *pByte++;
+        crc ^= (crc & 0xFF) >> 4;
+        crc ^= (uint16_t) (crc << 12);
+        crc ^= (uint16_t) ((crc & 0xFF) << 5);
+    }
+
+    return crc;
+}
+
+uint16_t CH9141_FRAME_Encode(void const *pData, uint16_t size, uint8_t *pFrame, uint16_t frameSize)
+{
+    return CH9141_FRAME_EncodeHeader(NULL, 0, pData, size, pFrame, frameSize);
+}
+
+uint16_t CH9141_FRAME_EncodeHeader(void const *pHeader, uint16_t headerSize, void const *pData, uint16_t size,
+                                   uint8_t *pFrame, uint16_t frameSize)
+{
+    uint16_t crc = CH9141_FRAME_CRC16(CH9141_FRAME_CRC16(0xFFFF, pHeader, headerSize), pData, size);
+    uint8_t const crcBytes[CH9141_FRAME_CRC_SIZE] = {(uint8_t) (crc >> 8), (uint8_t) crc};
+    uint8_t const *pHeaderByte = pHeader;
+    uint8_t const *pByte = pData;
+    uint32_t total = (uint32_t) headerSize + size + CH9141_FRAME_CRC_SIZE;
+    uint16_t codeAt = 0; // Offset of the current block code
+    uint16_t len = 1;
+    uint8_t code = 1;
+    uint8_t byte;
+
+    if (((pHeader == NULL) && (headerSize != 0)) || ((pData == NULL) && (size != 0)) || (pFrame == NULL) ||
+        (frameSize < 2))
+        return 0;
+
+    /* Header, message and CRC are encoded at once, block code is written when the block ends */
+    for (uint32_t i = 0; i < total; i++)
+    {
+        if (i < headerSize)
+            byte = pHeaderByte[i];
+        else if (i < (uint32_t) headerSize + size)
+            byte = pByte[i - headerSize];
+        else
+            byte = crcBytes[i - headerSize - size];
+        if (len == frameSize)
+            return 0;
+
+        if (byte == 0)
+        {
+            pFrame[codeAt] = code;
+            codeAt = len++;
+            code = 1;
+            continue;
+        }
+
+        pFrame[len++] = byte;
+        if (++code == 0xFF)
+        {
+            if (len == frameSize)
+                return 0;
+            pFrame[codeAt] = code;
+            codeAt = len++;
+            code = 1;
+        }
+    }
+    if (len == frameSize)
+        return 0;
+    pFrame[codeAt] = code;
+    pFrame[len++] = CH9141_FRAME_DELIMITER;
+
+    return len;
+}
+
+void CH9141_FRAME_DecoderInit(ch9141_FrameDecoder_t *decoder, uint8_t *buf, uint16_t size,
+                              ch9141_FrameReceived_fp received, void *context)
+{
+    if (decoder == NULL)
+        return;
+
+    memset(decoder, 0, sizeof(*decoder));
+    decoder->buf = buf;
+    decoder->size = size;
+    decoder->received = received;
+    decoder->context = context;
+}
+
+void CH9141_FRAME_Decode(ch9141_FrameDecoder_t *decoder, void const *pData, uint16_t size)
+{
+    uint8_t const *pByte = pData;
+
+    if ((decoder == NULL) || (pData == NULL))
+        return;
+
+    while (size--)
+    {
+        if (*pByte == CH9141_FRAME_DELIMITER)
+            Decoder_End(decoder);
+        else if (!decoder->discard)
+            Decoder_Put(decoder, *pByte);
+        pByte++;
+    }
+}
+
+void CH9141_FRAME_DecoderReset(ch9141_FrameDecoder_t *decoder)
+{
+    if (decoder == NULL)
+        return;
+
+    decoder->len = 0;
+    decoder->code = 0;
+    decoder->left = 0;
+    decoder->zeroPending = false;
+    decoder->discard = false;
+}
+
+/**
+ * @brief Internal function used to decode the next non-delimiter byte of the frame
+ * @param decoder pointer to the decoder
+ * @param byte received byte
+ */
+static void Decoder_Put(ch9141_FrameDecoder_t *decoder, uint8_t byte)
+{
+    /* Block code: previous block ends with zero, as the frame goes on */
+    if (decoder->left == 0)
+    {
+        if (decoder->zeroPending)
+        {
+            if (decoder->len == decoder->size)
+            {
+                decoder->discard = true;
+                decoder->stats.overflows++;
+                return;
+            }
+            decoder->buf[decoder->len++] = 0;
+        }
+        decoder->code = byte;
+        decoder->left = byte - 1;
+        decoder->zeroPending = (decoder->left == 0) && (byte != 0xFF);
+        return;
+    }
+
+    if (decoder->len == decoder->size)
+    {
+        decoder->discard = true;
+        decoder->stats.overflows++;
+        return;
+    }
+    decoder->buf[decoder->len++] = byte;
+    if (--decoder->left == 0)
+        decoder->zeroPending = decoder->code != 0xFF;
+}
+
+/**
+ * @brief Internal function used to complete the frame on delimiter
+ * @param decoder pointer to the decoder
+ */
+static void Decoder_End(ch9141_FrameDecoder_t *decoder)
+{
+    uint16_t crc;
+
+    /* Consecutive delimiters are just skipped */
+    if (decoder->discard || ((decoder->len == 0) && (decoder->code == 0)))
+    {
+        CH9141_FRAME_DecoderReset(decoder);
+        return;
+    }
+
+    if ((decoder->left != 0) || (decoder->len < CH9141_FRAME_CRC_SIZE))
+    {
+        decoder->stats.cobsErrors++;
+        CH9141_FRAME_DecoderReset(decoder);
+        return;
+    }
+
+    crc = CH9141_FRAME_CRC16(0xFFFF, decoder->buf, decoder->len - CH9141_FRAME_CRC_SIZE);
+    if ((decoder->buf[decoder->len - 2] != (crc >> 8)) || (decoder->buf[decoder->len - 1] != (crc & 0xFF)))
+    {
+        decoder->stats.crcErrors++;
+        CH9141_FRAME_DecoderReset(decoder);
+        return;
+    }
+
+    decoder->stats.frames++;
+    if (decoder->received != NULL)
+        decoder->received(decoder->buf, decoder->len - CH9141_FRAME_CRC_SIZE, decoder->context);
+    CH9141_FRAME_DecoderReset(decoder);
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @file ch9141_frame.h
+ * @brief Framing of the transparent mode byte stream: each message is followed by CRC-16/CCITT-FALSE (big-endian),
+ * COBS encoded and terminated by `0x00` delimiter. Decoder is fed with any chunks of the received stream and reports
+ * complete frames, so split or coalesced BLE packets keep the message boundaries. No dynamic memory is used: the caller
+ * provides the encoded frame buffer and the decoder buffer
+ */
+
+#define CH9141_FRAME_DELIMITER 0x00
+#define CH9141_FRAME_CRC_SIZE 2
+
+/* Max encoded frame length of the message of `size` bytes, delimiter included */
+#define CH9141_FRAME_ENCODED_MAX(size)                                                                                 \
+    ((size) + CH9141_FRAME_CRC_SIZE + ((size) + CH9141_FRAME_CRC_SIZE) / 254u + 2u)
+
+/**
+ * @brief Frame reception callback
+ * @param pData pointer to the message within the decoder buffer, valid until the callback returns
+ * @param size message length, CRC excluded
+ * @param context user context of the decoder
+ */
+typedef void (*ch9141_FrameReceived_fp)(uint8_t const *pData, uint16_t size, void *context);
+
+/* Incremental frame decoder */
+typedef struct ch9141_FrameDecoder_s {
+    uint8_t *buf; // Decoded message and CRC, provided by the user
+    uint16_t size; // Buffer size. Max message length is `size - CH9141_FRAME_CRC_SIZE`
+    ch9141_FrameReceived_fp received; // Called for each complete frame with valid CRC
+    void *context; // Optional user context passed to `received`
+
+    uint16_t len; // Number of bytes decoded so far
+    uint8_t code; // COBS code of the current block
+    uint8_t left; // Number of bytes left in the current block
+    bool zeroPending; // Current block ends with implicit zero, unless it is the last one
+    bool discard; // Frame is broken, data is dropped until the delimiter
+
+    struct {
+        uint32_t frames; // Number of frames received
+        uint32_t crcErrors; // Number of frames dropped due to CRC mismatch
+        uint32_t cobsErrors; // Number of frames dropped due to truncated COBS block or too short frame
+        uint32_t overflows; // Number of frames dropped due to buffer overflow
+    } stats;
+} ch9141_FrameDecoder_t;
+
+/**
+ * @brief Calculates CRC-16/CCITT-FALSE (poly `0x1021`, no reflection, no final XOR)
+ * @param crc initial value, `0xFFFF` for the new calculation or the previous result to continue
+ * @param pData pointer to the data
+ * @param size number of bytes
+ * @return Updated CRC
+ */
+uint16_t CH9141_FRAME_CRC16(uint16_t crc, void const *pData, uint16_t size);
+
+/**
+ * @brief Encodes the message into the frame ready to be transmitted
+ * @param pData pointer to the message
+ * @param size message length
+ * @param pFrame pointer to the frame buffer, `CH9141_FRAME_ENCODED_MAX(size)` bytes is enough
+ * @param frameSize frame buffer size
+ * @return Frame length, delimiter included. `0` if the frame buffer is too small
+ * @note Single pass, the message is not copied anywhere else
+ */
+uint16_t CH9141_FRAME_Encode(void const *pData, uint16_t size, uint8_t *pFrame, uint16_t frameSize);
+
+/**
+ * @brief Encodes the message preceded by the header into the single frame
+ * @param pHeader pointer to the header
+ * @param headerSize header length
+ * @param pData pointer to the message
+ * @param size message length
+ * @param pFrame pointer to the frame buffer, `CH9141_FRAME_ENCODED_MAX(headerSize + size)` bytes is enough
+ * @param frameSize frame buffer size
+ * @return Frame length, delimiter included. `0` if the frame buffer is too small
+ * @note Lets the upper layers prepend their headers without copying the message
+ */
+uint16_t CH9141_FRAME_EncodeHeader(void const *pHeader, uint16_t headerSize, void const *pData, uint16_t size,
+                                   uint8_t *pFrame, uint16_t frameSize);
+
+/**
+ * @brief Initializes the decoder
+ * @param decoder pointer to the decoder
+ * @param buf pointer to the buffer for the decoded message and CRC
+ * @param size buffer size
+ * @param received frame reception callback
+ * @param context optional user context passed to `received`
+ */
+void CH9141_FRAME_DecoderInit(ch9141_FrameDecoder_t *decoder, uint8_t *buf, uint16_t size,
+                              ch9141_FrameReceived_fp received, void *context);
+
+/**
+ * @brief Feeds the decoder with the received data. `received` callback is called for each complete frame
+ * @param decoder pointer to the decoder
+ * @param pData pointer to the received data, any part of the stream
+ * @param size number of bytes
+ * @note Decoder synchronizes on the next delimiter after any broken frame
+ */
+void CH9141_FRAME_Decode(ch9141_FrameDecoder_t *decoder, void const *pData, uint16_t size);
+
+/**
+ * @brief Drops the partially received frame, e.g. after the link loss
+ * @param decoder pointer to the decoder
+ */
+void CH9141_FRAME_DecoderReset(ch9141_FrameDecoder_t *decoder);
@@ -0,0 +1,255 @@
+#include "ch9141_mux.h"
+
+static void Mux_FrameReceived(uint8_t const *pData, uint16_t size, void *context);
+static void Mux_Release(ch9141_Mux_t *mux);
+static uint8_t Mux_Schedule(ch9141_Mux_t *mux);
+
+ch9141_ErrorStatus_t CH9141_MUX_Init(ch9141_Mux_t *mux)
+{
+    ch9141_MuxChannel_t *ch;
+
+    if (mux == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Check arguments */
+    if (mux->transmit == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    if (mux->inFlightMax == 0)
+        mux->inFlightMax = 1;
+    for (uint8_t i = 0; i < CH9141_MUX_CHANNEL_NUM; i++)
+    {
+        ch = &mux->channel[i];
+        if (ch->weight == 0)
+            ch->weight = 1;
+        ch->head = CH9141_MUX_NONE;
+        ch->tail = CH9141_MUX_NONE;
+        ch->queued = 0;
+        ch->credit = ch->weight;
+        memset(&ch->stats, 0, sizeof(ch->stats));
+    }
+
+    memset(&mux->decoder, 0, sizeof(ch9141_Mux_t) - offsetof(ch9141_Mux_t, decoder));
+    CH9141_FRAME_DecoderInit(&mux->decoder, mux->rxBuf, sizeof(mux->rxBuf), Mux_FrameReceived, mux);
+    for (uint8_t i = 0; i < CH9141_MUX_BLOCK_NUM; i++)
+        mux->blocks[i].next = (i + 1 < CH9141_MUX_BLOCK_NUM) ? i + 1 : CH9141_MUX_NONE;
+    mux->free = 0;
+    mux->freeNum = CH9141_MUX_BLOCK_NUM;
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+ch9141_ErrorStatus_t CH9141_MUX_Write(ch9141_Mux_t *mux, uint8_t channel, void const *pData, uint16_t size)
+{
+    ch9141_MuxChannel_t *ch;
+    ch9141_MuxBlock_t *block;
+    uint8_t const *pByte = pData;
+    uint16_t chunks = (size == 0) ? 1 : (uint16_t) ((size + CH9141_MUX_CHUNK_MAX - 1) / CH9141_MUX_CHUNK_MAX);
+    uint16_t chunk;
+    uint8_t header;
+    uint8_t idx;
+
+    if (mux == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Check arguments */
+    if ((channel >= CH9141_MUX_CHANNEL_NUM) || ((pData == NULL) && (size != 0)))
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Whole message or nothing */
+    ch = &mux->channel[channel];
+    if ((chunks > mux->freeNum) || ((ch->quota != 0) && (ch->queued + chunks > ch->quota)))
+    {
+        ch->stats.refused++;
+        return CH9141_ERROR_STATUS_ERROR;
+    }
+
+    while (chunks--)
+    {
+        chunk = (size > CH9141_MUX_CHUNK_MAX) ? CH9141_MUX_CHUNK_MAX : size;
+        header = channel | ((chunks == 0) ? CH9141_MUX_HEADER_LAST : 0);
+
+        idx = mux->free;
+        block = &mux->blocks[idx];
+        mux->free = block->next;
+        mux->freeNum--;
+
+        block->len = CH9141_FRAME_EncodeHeader(&header, sizeof(header), pByte, chunk, block->frame,
+                                               sizeof(block->frame));
+        block->next = CH9141_MUX_NONE;
+        if (ch->tail == CH9141_MUX_NONE)
+            ch->head = idx;
+        else
+            mux->blocks[ch->tail].next = idx;
+        ch->tail = idx;
+        ch->queued++;
+
+        if (pByte != NULL)
+            pByte += chunk;
+        size -= chunk;
+    }
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+void CH9141_MUX_Receive(ch9141_Mux_t *mux, void const *pData, uint16_t size)
+{
+    if (mux == NULL)
+        return;
+
+    CH9141_FRAME_Decode(&mux->decoder, pData, size);
+}
+
+void CH9141_MUX_Process(ch9141_Mux_t *mux)
+{
+    ch9141_MuxChannel_t *ch;
+    ch9141_MuxBlock_t *block;
+    uint8_t channel;
+    uint8_t idx;
+
+    if (mux == NULL)
+        return;
+
+    Mux_Release(mux);
+
+    while (mux->sentNum < mux->inFlightMax)
+    {
+        channel = Mux_Schedule(mux);
+        if (channel == CH9141_MUX_NONE)
+            return;
+
+        ch = &mux->channel[channel];
+        idx = ch->head;
+        block = &mux->blocks[idx];
+        if (mux->transmit(block->frame, block->len, mux->context) != CH9141_ERROR_STATUS_SUCCESS)
+            return;
+
+        /* Block is owned by the transmit function until done */
+        ch->head = block->next;
+        if (ch->head == CH9141_MUX_NONE)
+            ch->tail = CH9141_MUX_NONE;
+        ch->queued--;
+        ch->credit--;
+        ch->stats.txBytes += block->len;
+        mux->sent[(mux->sentHead + mux->sentNum) % CH9141_MUX_BLOCK_NUM] = idx;
+        mux->sentNum++;
+        mux->stats.frames++;
+    }
+}
+
+void CH9141_MUX_TxDone(ch9141_Mux_t *mux)
+{
+    if (mux == NULL)
+        return;
+
+    mux->txDone++;
+}
+
+uint8_t CH9141_MUX_Queued(ch9141_Mux_t const *mux, uint8_t channel)
+{
+    if ((mux == NULL) || (channel >= CH9141_MUX_CHANNEL_NUM))
+        return 0;
+
+    return mux->channel[channel].queued;
+}
+
+/**
+ * @brief Internal function used to dispatch the decoded chunk to its channel
+ * @param pData pointer to the chunk with header
+ * @param size chunk length with header
+ * @param context pointer to the multiplexer
+ */
+static void Mux_FrameReceived(uint8_t const *pData, uint16_t size, void *context)
+{
+    ch9141_Mux_t *mux = context;
+    ch9141_MuxChannel_t *ch;
+    uint8_t channel;
+
+    if (size < CH9141_MUX_HEADER_SIZE)
+        return;
+
+    channel = (uint8_t) (pData[0] & ~CH9141_MUX_HEADER_LAST);
+    if (channel >= CH9141_MUX_CHANNEL_NUM)
+    {
+        mux->stats.unknownChannel++;
+        return;
+    }
+
+    ch = &mux->channel[channel];
+    ch->stats.rxBytes += size - CH9141_MUX_HEADER_SIZE;
+    if (ch->received != NULL)
+        ch->received(channel, pData + CH9141_MUX_HEADER_SIZE, size - CH9141_MUX_HEADER_SIZE,
+                     (pData[0] & CH9141_MUX_HEADER_LAST) != 0, mux->context);
+}
+
+/**
+ * @brief Internal function used to return the done frames to the pool in the transmission order
+ * @param mux pointer to the multiplexer
+ */
+static void Mux_Release(ch9141_Mux_t *mux)
+{
+    uint16_t done = mux->txDone;
+    uint8_t idx;
+
+    while ((mux->txReleased != done) && (mux->sentNum != 0))
+    {
+        idx = mux->sent[mux->sentHead];
+        mux->sentHead = (uint8_t) ((mux->sentHead + 1) % CH9141_MUX_BLOCK_NUM);
+        mux->sentNum--;
+        mux->blocks[idx].next = mux->free;
+        mux->free = idx;
+        mux->freeNum++;
+        mux->txReleased++;
+    }
+}
+
+/**
+ * @brief Internal function used to pick the channel to send the next chunk from
+ * @param mux pointer to the multiplexer
+ * @return Channel number. CH9141_MUX_NONE if all the channels are empty
+ * @note Strict priority between the levels, weighted round-robin within the level. Channel keeps the turn until its
+ * credit is spent
+ */
+static uint8_t Mux_Schedule(ch9141_Mux_t *mux)
+{
+    ch9141_MuxChannel_t *ch;
+    uint8_t priority = UINT8_MAX;
+    uint8_t channel;
+    bool pending = false;
+
+    for (uint8_t i = 0; i < CH9141_MUX_CHANNEL_NUM; i++)
+    {
+        ch = &mux->channel[i];
+        if ((ch->queued != 0) && (!pending || (ch->priority < priority)))
+        {
+            priority = ch->priority;
+            pending = true;
+        }
+    }
+    if (!pending)
+        return CH9141_MUX_NONE;
+
+    for (uint8_t round = 0; round < 2; round++)
+    {
+        for (uint8_t i = 0; i < CH9141_MUX_CHANNEL_NUM; i++)
+        {
+            channel = (mux->cursor + i) % CH9141_MUX_CHANNEL_NUM;
+            ch = &mux->channel[channel];
+            if ((ch->queued == 0) || (ch->priority != priority) || (ch->credit == 0))
+                continue;
+
+            mux->cursor = (ch->credit == 1) ? (uint8_t) ((channel + 1) % CH9141_MUX_CHANNEL_NUM) : channel;
+            return channel;
+        }
+
+        /* Round is over for the level */
+        for (uint8_t i = 0; i < CH9141_MUX_CHANNEL_NUM; i++)
+        {
+            ch = &mux->channel[i];
+            if (ch->priority == priority)
+                ch->credit = ch->weight;
+        }
+    }
+
+    return CH9141_MUX_NONE;
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "ch9141.h"
+#include "ch9141_frame.h"
+
+/**
+ * @file ch9141_mux.h
+ * @brief Logical channels over the transparent mode stream. Messages are split into chunks held by the static block
+ * pool, each chunk is sent as a separate frame tagged with its channel. Channels of the higher priority are served
+ * first, channels of the same priority share the link by weighted round-robin. Only `inFlightMax` frames are handed to
+ * the transmit function at once, so urgent messages do not wait behind the bulk transfer queued in the port
+ */
+
+#ifndef CH9141_MUX_CHANNEL_NUM
+#define CH9141_MUX_CHANNEL_NUM 4 // Number of logical channels, up to 127
+#endif
+#ifndef CH9141_MUX_BLOCK_NUM
+#define CH9141_MUX_BLOCK_NUM 16 // Number of pool blocks, up to 255
+#endif
+#ifndef CH9141_MUX_CHUNK_MAX
+#define CH9141_MUX_CHUNK_MAX 64 // Max message part carried by a single frame
+#endif
+
+#define CH9141_MUX_HEADER_SIZE 1 // Channel number and end of message flag
+#define CH9141_MUX_HEADER_LAST 0x80 // Chunk completes the message
+#define CH9141_MUX_FRAME_MAX CH9141_FRAME_ENCODED_MAX(CH9141_MUX_CHUNK_MAX + CH9141_MUX_HEADER_SIZE)
+#define CH9141_MUX_NONE 0xFF // End of the block list
+
+/**
+ * @brief Transmits the encoded frame
+ * @param pFrame pointer to the frame, unchanged until CH9141_MUX_TxDone() is called for it
+ * @param size frame length
+ * @param context user context of the multiplexer
+ * @return Status of the data transfer request operation
+ */
+typedef ch9141_ErrorStatus_t (*ch9141_MuxTransmit_fp)(uint8_t const *pFrame, uint16_t size, void *context);
+
+/**
+ * @brief Chunk reception callback
+ * @param channel channel number
+ * @param pData pointer to the chunk, valid until the callback returns
+ * @param size chunk length
+ * @param last chunk completes the message
+ * @param context user context of the multiplexer
+ */
+typedef void (*ch9141_MuxReceived_fp)(uint8_t channel, uint8_t const *pData, uint16_t size, bool last, void *context);
+
+/* Pool block holding the encoded chunk */
+typedef struct ch9141_MuxBlock_s {
+    uint8_t frame[CH9141_MUX_FRAME_MAX];
+    uint16_t len; // Frame length
+    uint8_t next; // Next block of the channel queue or the free list
+} ch9141_MuxBlock_t;
+
+typedef struct ch9141_MuxChannel_s {
+    /* Set by the user before CH9141_MUX_Init() */
+    uint8_t priority; // 0 is the highest
+    uint8_t weight; // Chunks sent in turn among the channels of the same priority. 0 means 1
+    uint8_t quota; // Max number of pool blocks queued by the channel. 0 means no limit
+    ch9141_MuxReceived_fp received; // Optional
+
+    uint8_t head; // First queued block
+    uint8_t tail; // Last queued block
+    uint8_t queued; // Number of queued blocks
+    uint8_t credit; // Chunks left in the current round
+
+    struct {
+        uint32_t txBytes; // Number of frame bytes sent
+        uint32_t rxBytes; // Number of message bytes received
+        uint32_t refused; // Number of messages refused due to quota or pool exhaustion
+    } stats;
+} ch9141_MuxChannel_t;
+
+typedef struct ch9141_Mux_s {
+    /* Set by the user before CH9141_MUX_Init() */
+    ch9141_MuxTransmit_fp transmit;
+    void *context; // Optional user context passed to `transmit` and `received`
+    uint8_t inFlightMax; // Max number of frames handed to the transmit function and not done yet. 0 means 1
+    ch9141_MuxChannel_t channel[CH9141_MUX_CHANNEL_NUM];
+
+    ch9141_FrameDecoder_t decoder;
+    uint8_t rxBuf[CH9141_MUX_CHUNK_MAX + CH9141_MUX_HEADER_SIZE + CH9141_FRAME_CRC_SIZE];
+    ch9141_MuxBlock_t blocks[CH9141_MUX_BLOCK_NUM];
+    uint8_t free; // First free block
+    uint8_t freeNum; // Number of free blocks
+    uint8_t sent[CH9141_MUX_BLOCK_NUM]; // Blocks handed to the transmit function, in order
+    uint8_t sentHead;
+    uint8_t sentNum;
+    volatile uint16_t txDone; // Incremented by CH9141_MUX_TxDone()
+    uint16_t txReleased; // Number of done frames returned to the pool
+    uint8_t cursor; // Round-robin position
+
+    struct {
+        uint32_t frames; // Number of frames sent
+        uint32_t unknownChannel; // Number of received frames of the unknown channel
+    } stats;
+} ch9141_Mux_t;
+
+/**
+ * @brief Initializes the multiplexer state and the block pool
+ * @param mux pointer to the multiplexer
+ * @return Status of the operation
+ */
+ch9141_ErrorStatus_t CH9141_MUX_Init(ch9141_Mux_t *mux);
+
+/**
+ * @brief Queues the message to the channel
+ * @param mux pointer to the multiplexer
+ * @param channel channel number
+ * @param pData pointer to the message, copied into the pool
+ * @param size message length
+ * @return Status of the operation. Error if the channel quota or the pool is exhausted, nothing is queued then
+ */
+ch9141_ErrorStatus_t CH9141_MUX_Write(ch9141_Mux_t *mux, uint8_t channel, void const *pData, uint16_t size);
+
+/**
+ * @brief Feeds the multiplexer with the received stream and dispatches the chunks to the channels
+ * @param mux pointer to the multiplexer
+ * @param pData pointer to the received data, any part of the stream
+ * @param size number of bytes
+ */
+void CH9141_MUX_Receive(ch9141_Mux_t *mux, void const *pData, uint16_t size);
+
+/**
+ * @brief Returns the done frames to the pool and schedules the next ones
+ * @param mux pointer to the multiplexer
+ * @note Must be called periodically, e.g. from the main loop
+ */
+void CH9141_MUX_Process(ch9141_Mux_t *mux);
+
+/**
+ * @brief Reports the oldest frame handed to the transmit function as done
+ * @param mux pointer to the multiplexer
+ * @note Interrupt safe, e.g. called from the transmit queue completion callback
+ */
+void CH9141_MUX_TxDone(ch9141_Mux_t *mux);
+
+/**
+ * @brief Returns the number of blocks queued by the channel
+ * @param mux pointer to the multiplexer
+ * @param channel channel number
+ * @return Number of blocks, not sent yet
+ */
+uint8_t CH9141_MUX_Queued(ch9141_Mux_t const *mux, uint8_t channel);
@@ -0,0 +1,240 @@
+#include "ch9141_shaper.h"
+
+#define SHAPER_CHUNK(shaper, n) ((uint8_t) (((shaper)->first + (n)) % CH9141_SHAPER_CHUNK_NUM))
+
+static void Shaper_Close(ch9141_Shaper_t *shaper);
+static void Shaper_Release(ch9141_Shaper_t *shaper);
+static void Shaper_Refill(ch9141_Shaper_t *shaper, uint32_t now);
+static void Shaper_Measure(ch9141_Shaper_t *shaper, uint32_t now);
+
+ch9141_ErrorStatus_t CH9141_SHAPER_Init(ch9141_Shaper_t *shaper)
+{
+    if (shaper == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Check arguments */
+    if ((shaper->transmit == NULL) || (shaper->tick == NULL) || (shaper->chunkSize > CH9141_SHAPER_CHUNK_MAX) ||
+        (shaper->inFlightMax > CH9141_SHAPER_CHUNK_NUM))
+        return CH9141_ERROR_STATUS_ERROR;
+
+    if (shaper->chunkSize == 0)
+        shaper->chunkSize = 20;
+    if (shaper->burst == 0)
+        shaper->burst = 2 * shaper->chunkSize;
+    if (shaper->inFlightMax == 0)
+        shaper->inFlightMax = 2;
+    memset(&shaper->chunks, 0, sizeof(ch9141_Shaper_t) - offsetof(ch9141_Shaper_t, chunks));
+    shaper->lastTick = shaper->tick();
+    shaper->measure.start = shaper->lastTick;
+    shaper->tokens = (uint32_t) shaper->burst * 1000;
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+ch9141_ErrorStatus_t CH9141_SHAPER_Write(ch9141_Shaper_t *shaper, void const *pData, uint16_t size)
+{
+    uint8_t const *pByte = pData;
+    uint32_t room;
+    uint16_t part;
+    uint8_t idx;
+
+    if (shaper == NULL)
+        return CH9141_ERROR_STATUS_ERROR;
+
+    /* Check arguments */
+    if ((pData == NULL) && (size != 0))
+        return CH9141_ERROR_STATUS_ERROR;
+
+    room = (uint32_t) (CH9141_SHAPER_CHUNK_NUM - shaper->sentNum - shaper->readyNum) * shaper->chunkSize -
+           shaper->openLen;
+    if (size > room)
+    {
+        shaper->stats.refused++;
+        return CH9141_ERROR_STATUS_ERROR;
+    }
+
+    while (size != 0)
+    {
+        idx = SHAPER_CHUNK(shaper, shaper->sentNum + shaper->readyNum);
+        if (shaper->openLen == 0)
+            shaper->openSince = shaper->tick();
+
+        part = shaper->chunkSize - shaper->openLen;
+        if (part > size)
+            part = size;
+        memcpy(&shaper->chunks[idx][shaper->openLen], pByte, part);
+        shaper->openLen += part;
+        pByte += part;
+        size -= part;
+
+        /* Full chunk is ready at once */
+        if (shaper->openLen == shaper->chunkSize)
+            Shaper_Close(shaper);
+    }
+    shaper->stats.writes++;
+    shaper->stats.bytes += (uint32_t) (pByte - (uint8_t const *) pData);
+
+    return CH9141_ERROR_STATUS_SUCCESS;
+}
+
+void CH9141_SHAPER_Flush(ch9141_Shaper_t *shaper)
+{
+    if ((shaper == NULL) || (shaper->openLen == 0))
+        return;
+
+    Shaper_Close(shaper);
+}
+
+void CH9141_SHAPER_Process(ch9141_Shaper_t *shaper)
+{
+    uint32_t now;
+    uint32_t cost;
+    uint8_t idx;
+
+    if (shaper == NULL)
+        return;
+
+    Shaper_Release(shaper);
+    now = shaper->tick();
+    Shaper_Refill(shaper, now);
+
+    /* Partial chunk */
+    if ((shaper->openLen != 0) && (now - shaper->openSince >= shaper->deadline))
+    {
+        Shaper_Close(shaper);
+        shaper->stats.deadlineFlushes++;
+    }
+
+    while (shaper->readyNum != 0)
+    {
+        idx = SHAPER_CHUNK(shaper, shaper->sentNum);
+        cost = (uint32_t) shaper->len[idx] * 1000;
+        if (shaper->sentNum >= shaper->inFlightMax)
+        {
+            shaper->measure.backlogged = true;
+            break;
+        }
+        if ((CH9141_SHAPER_Rate(shaper) != 0) && (shaper->tokens < cost))
+        {
+            shaper->measure.backlogged = true;
+            shaper->stats.throttled++;
+            break;
+        }
+
+        if (shaper->transmit(shaper->chunks[idx], shaper->len[idx], shaper->context) != CH9141_ERROR_STATUS_SUCCESS)
+            break;
+        shaper->tokens = (shaper->tokens > cost) ? shaper->tokens - cost : 0;
+        shaper->measure.pending += shaper->len[idx];
+        shaper->readyNum--;
+        shaper->sentNum++;
+        shaper->stats.chunks++;
+    }
+
+    Shaper_Measure(shaper, now);
+}
+
+void CH9141_SHAPER_TxDone(ch9141_Shaper_t *shaper)
+{
+    if (shaper == NULL)
+        return;
+
+    shaper->txDone++;
+}
+
+void CH9141_SHAPER_Delivered(ch9141_Shaper_t *shaper, uint32_t size)
+{
+    if (shaper == NULL)
+        return;
+
+    shaper->measure.bytes += size;
+    shaper->measure.pending = (shaper->measure.pending > size) ? shaper->measure.pending - size : 0;
+}
+
+uint32_t CH9141_SHAPER_Rate(ch9141_Shaper_t const *shaper)
+{
+    if (shaper == NULL)
+        return 0;
+
+    if (shaper->rate != 0)
+        return shaper->rate;
+
+    /* Standing link queue is drained below the estimate, otherwise headroom lets the estimate grow */
+    if (shaper->measure.pending > shaper->burst)
+        return shaper->measure.estimate - shaper->measure.estimate / 8;
+    return shaper->measure.estimate + shaper->measure.estimate / 4;
+}
+
+/**
+ * @brief Internal function used to make the chunk being filled ready for transmission
+ * @param shaper pointer to the shaper
+ */
+static void Shaper_Close(ch9141_Shaper_t *shaper)
+{
+    uint8_t idx = SHAPER_CHUNK(shaper, shaper->sentNum + shaper->readyNum);
+
+    shaper->len[idx] = shaper->openLen;
+    shaper->openLen = 0;
+    shaper->readyNum++;
+}
+
+/**
+ * @brief Internal function used to return the done chunks to the buffer
+ * @param shaper pointer to the shaper
+ */
+static void Shaper_Release(ch9141_Shaper_t *shaper)
+{
+    uint16_t done = shaper->txDone;
+
+    while ((shaper->txReleased != done) && (shaper->sentNum != 0))
+    {
+        shaper->first = SHAPER_CHUNK(shaper, 1);
+        shaper->sentNum--;
+        shaper->txReleased++;
+    }
+}
+
+/**
+ * @brief Internal function used to add the tokens earned since the previous call
+ * @param shaper pointer to the shaper
+ * @param now [ms]. Current time
+ */
+static void Shaper_Refill(ch9141_Shaper_t *shaper, uint32_t now)
+{
+    uint32_t elapsed = now - shaper->lastTick;
+    uint32_t limit = (uint32_t) shaper->burst * 1000;
+
+    shaper->lastTick = now;
+    if (elapsed > 1000)
+        elapsed = 1000;
+    shaper->tokens += elapsed * CH9141_SHAPER_Rate(shaper);
+    if (shaper->tokens > limit)
+        shaper->tokens = limit;
+}
+
+/**
+ * @brief Internal function used to update the throughput estimate
+ * @param shaper pointer to the shaper
+ * @param now [ms]. Current time
+ * @note Periods without the backlog tell nothing about the link and are skipped
+ */
+static void Shaper_Measure(ch9141_Shaper_t *shaper, uint32_t now)
+{
+    uint32_t elapsed = now - shaper->measure.start;
+    uint32_t sample;
+
+    if (elapsed < CH9141_SHAPER_MEASURE_PERIOD)
+        return;
+
+    if (shaper->measure.pending > shaper->chunkSize)
+        shaper->measure.backlogged = true;
+
+    if (shaper->measure.backlogged && (shaper->measure.bytes != 0))
+    {
+        sample = (uint32_t) ((uint64_t) shaper->measure.bytes * 1000 / elapsed);
+        shaper->measure.estimate =
+            (shaper->measure.estimate == 0) ? sample : (shaper->measure.estimate * 7 + sample) / 8;
+    }
+    shaper->measure.start = now;
+    shaper->measure.bytes = 0;
+    shaper->measure.backlogged = false;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "ch9141.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @file ch9141_shaper.h
+ * @brief Transmit shaper in front of the transparent mode send path. Small writes are coalesced into chunks of the BLE
+ * payload size, a partial chunk is sent once its oldest byte waits for `deadline`. Chunks are paced by the token bucket
+ * to the configured throughput or to the one measured from the delivery reports, so bursts do not overflow the chip
+ */
+
+#ifndef CH9141_SHAPER_CHUNK_MAX
+#define CH9141_SHAPER_CHUNK_MAX 128 // Max chunk size
+#endif
+#ifndef CH9141_SHAPER_CHUNK_NUM
+#define CH9141_SHAPER_CHUNK_NUM 8 // Number of chunk buffers
+#endif
+#define CH9141_SHAPER_MEASURE_PERIOD 250 // [ms]. Throughput measurement period
+
+/**
+ * @brief Transmits the chunk
+ * @param pData pointer to the chunk, unchanged until CH9141_SHAPER_TxDone() is called for it
+ * @param size chunk length
+ * @param context user context of the shaper
+ * @return Status of the data transfer request operation
+ */
+typedef ch9141_ErrorStatus_t (*ch9141_ShaperTransmit_fp)(uint8_t const *pData, uint16_t size, void *context);
+
+typedef struct ch9141_Shaper_s {
+    /* Set by the user before CH9141_SHAPER_Init() */
+    ch9141_ShaperTransmit_fp transmit;
+    ch9141_Tick_fp tick;
+    void *context; // Optional user context passed to `transmit`
+    uint16_t chunkSize; // BLE payload size, up to CH9141_SHAPER_CHUNK_MAX. 0 means 20
+    uint16_t deadline; // [ms]. Max time the written byte waits for the chunk to be filled
+    uint32_t rate; // [B/s]. Link throughput. 0 means measured by CH9141_SHAPER_Delivered(), not paced until then
+    uint16_t burst; // Max number of bytes sent at once after the idle period. 0 means 2 chunks
+    uint8_t inFlightMax; // Max number of chunks handed to the transmit function and not done yet. 0 means 2
+
+    uint8_t chunks[CH9141_SHAPER_CHUNK_NUM][CH9141_SHAPER_CHUNK_MAX];
+    uint16_t len[CH9141_SHAPER_CHUNK_NUM];
+    uint8_t first; // Oldest chunk handed to the transmit function
+    uint8_t sentNum; // Number of chunks handed to the transmit function
+    uint8_t readyNum; // Number of chunks waiting for transmission
+    uint16_t openLen; // Length of the chunk being filled, it follows the ready ones
+    uint32_t openSince; // [ms]. Time of the first byte of the chunk being filled
+    uint32_t tokens; // [B/1000]. Token bucket
+    uint32_t lastTick; // [ms]. Time of the previous bucket refill
+    volatile uint16_t txDone; // Incremented by CH9141_SHAPER_TxDone()
+    uint16_t txReleased; // Number of done chunks returned to the buffer
+
+    struct {
+        uint32_t start; // [ms]. Start of the current period
+        uint32_t bytes; // Number of bytes delivered within the current period
+        uint32_t pending; // Number of bytes sent and not reported as delivered yet
+        uint32_t estimate; // [B/s]. Smoothed throughput, 0 until measured
+        bool backlogged; // Chunks waited for transmission or the link queue stood within the current period
+    } measure;
+
+    struct {
+        uint32_t writes; // Number of writes accepted
+        uint32_t bytes; // Number of bytes accepted
+        uint32_t chunks; // Number of chunks sent
+        uint32_t deadlineFlushes; // Number of partial chunks sent on deadline
+        uint32_t refused; // Number of writes refused due to no room
+        uint32_t throttled; // Number of times the ready chunk waited for tokens
+    } stats;
+} ch9141_Shaper_t;
+
+/**
+ * @brief Initializes the shaper state
+ * @param shaper pointer to the shaper
+ * @return Status of the operation
+ */
+ch9141_ErrorStatus_t CH9141_SHAPER_Init(ch9141_Shaper_t *shaper);
+
+/**
+ * @brief Appends the data to the chunk being filled
+ * @param shaper pointer to the shaper
+ * @param pData pointer to the data, copied
+ * @param size number of bytes
+ * @return Status of the operation. Error if there is no room for the whole data, nothing is written then
+ */
+ch9141_ErrorStatus_t CH9141_SHAPER_Write(ch9141_Shaper_t *shaper, void const *pData, uint16_t size);
+
+/**
+ * @brief Closes the chunk being filled regardless of the deadline, e.g. before the power off
+ * @param shaper pointer to the shaper
+ * @note Ready chunks are sent by the next CH9141_SHAPER_Process() call
+ */
+void CH9141_SHAPER_Flush(ch9141_Shaper_t *shaper);
+
+/**
+ * @brief Closes the chunk on size or deadline and sends the ready chunks as the tokens allow
+ * @param shaper pointer to the shaper
+ * @note Must be called periodically, e.g. from the main loop
+ */
+void CH9141_SHAPER_Process(ch9141_Shaper_t *shaper);
+
+/**
+ * @brief Reports the oldest chunk handed to the transmit function as done
+ * @param shaper pointer to the shaper
+ * @note Interrupt safe, e.g. called from the transmit queue completion callback
+ */
+void CH9141_SHAPER_TxDone(ch9141_Shaper_t *shaper);
+
+/**
+ * @brief Reports the bytes delivered over the link, e.g. acknowledged by the peer, to measure the throughput
+ * @param shaper pointer to the shaper
+ * @param size number of bytes
+ */
+void CH9141_SHAPER_Delivered(ch9141_Shaper_t *shaper, uint32_t size);
+
+/**
+ * @brief Returns the throughput the output is paced to
+ * @param shaper pointer to the shaper
+ * @return [B/s]. 0 if the output is not paced
+ */
+uint32_t CH9141_SHAPER_Rate(ch9141_Shaper_t const *shaper);
@@ -57,6 +57,8 @@ void PendSV_Handler(void);
 void SysTick_Handler(void);
 void UART4_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void DMA1_Stream2_IRQHandler(void);
+void DMA1_Stream4_IRQHandler(void);
 
 /* USER CODE END EFP */
 
@@ -24,6 +24,8 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "ch9141_demo.h"
+#include "ch9141_dispatch.h"
+#include "ch9141_shaper.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -33,6 +35,7 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+#define POWER_OFF_DRAIN_TIMEOUT 1000 // [ms]. Max time the reply waits in the shaper before the power off
 
 /* USER CODE END PD */
 
@@ -45,18 +48,35 @@
 
 /* USER CODE BEGIN PV */
 static ch9141_t ch9141;
+static ch9141_Shaper_t shaper;
+static ch9141_Dispatcher_t dispatcher;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 
 /* USER CODE BEGIN PFP */
-
+static ch9141_ErrorStatus_t Shaper_Transmit(uint8_t const *pData, uint16_t size, void *context);
+static void Shaper_Done(void const *pData, uint16_t size, void *context, bool ok);
+static void Verb_LedRed(int32_t const *args, uint8_t argc, void *context);
+static void Verb_LedGreen(int32_t const *args, uint8_t argc, void *context);
+static void Verb_LedBlue(int32_t const *args, uint8_t argc, void *context);
+static void Verb_Disable(int32_t const *args, uint8_t argc, void *context);
+static void Verb_PowerOff(int32_t const *args, uint8_t argc, void *context);
+static void Verb_Status(int32_t const *args, uint8_t argc, void *context);
+static void Job_Status(ch9141_t *ble, void *context);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
-
+static ch9141_Verb_t const verbs[] = {
+    {"LEDR", Verb_LedRed, NULL},
+    {"LEDG", Verb_LedGreen, NULL},
+    {"LEDB", Verb_LedBlue, NULL},
+    {"DISA", Verb_Disable, NULL},
+    {"POWF", Verb_PowerOff, NULL},
+    {"STAT", Verb_Status, NULL},
+};
 /* USER CODE END 0 */
 
 /**
@@ -96,6 +116,19 @@ int main(void)
     // CH9141_Demo();
     if (CH9141_SetUp(&ch9141) == ERROR)
         Error_Handler();
+    if (CH9141_RxStart() == ERROR)
+        Error_Handler();
+    shaper.transmit = Shaper_Transmit;
+    shaper.tick = CH9141_Tick;
+    shaper.chunkSize = 20; // Default ATT MTU payload
+    shaper.deadline = 20; // [ms]
+    shaper.rate = 2000; // [B/s]
+    if (CH9141_SHAPER_Init(&shaper) != CH9141_ERROR_STATUS_SUCCESS)
+        Error_Handler();
+    dispatcher.verbs = verbs;
+    dispatcher.verbNum = sizeof(verbs) / sizeof(verbs[0]);
+    if (CH9141_DISPATCH_Init(&dispatcher) != CH9141_ERROR_STATUS_SUCCESS)
+        Error_Handler();
     LEDG_OFF;
     /* USER CODE END 2 */
 
@@ -103,39 +136,16 @@ int main(void)
     /* USER CODE BEGIN WHILE */
     while (1)
     {
-        static char msg[50];
-
-        HAL_UARTEx_ReceiveToIdle_IT(&huart4, (uint8_t *) msg, sizeof(msg));
-        if (memcmp(msg, "LEDR", 4) == 0)
-        {
-            LEDR_ON, LEDG_OFF, LEDB_OFF;
-            HAL_UART_Transmit_IT(&huart4, "OK Red", 6);
-            memset(msg, '\0', sizeof(msg));
-        }
-        else if (memcmp(msg, "LEDG", 4) == 0)
-        {
-            LEDR_OFF, LEDG_ON, LEDB_OFF;
-            HAL_UART_Transmit_IT(&huart4, "OK Green", 8);
-            memset(msg, '\0', sizeof(msg));
-        }
-        else if (memcmp(msg, "LEDB", 4) == 0)
-        {
-            LEDR_OFF, LEDG_OFF, LEDB_ON;
-            HAL_UART_Transmit_IT(&huart4, "OK Blue", 7);
-            memset(msg, '\0', sizeof(msg));
-        }
-        else if (memcmp(msg, "DISA", 4) == 0)
-        {
-            LEDR_OFF, LEDG_OFF, LEDB_OFF;
-            HAL_UART_Transmit_IT(&huart4, "OK Disable", 10);
-            memset(msg, '\0', sizeof(msg));
-        }
-        else if (memcmp(msg, "POWF", 4) == 0)
-        {
-            HAL_UART_Transmit_IT(&huart4, "OK Power Off", 10);
-            HAL_Delay(3000);
-            PWR_OFF;
-        }
+        char buf[32];
+        uint16_t len;
+
+        /* Verbs are recognized at any position of the stream */
+        while ((len = CH9141_Read(buf, sizeof(buf))) != 0)
+            CH9141_DISPATCH_Feed(&dispatcher, buf, len);
+
+        /* AT jobs run while the stream is paused */
+        CH9141_ArbiterProcess(&ch9141);
+        CH9141_SHAPER_Process(&shaper);
 
         if (BTN_CHECK == GPIO_PIN_RESET)
             PWR_OFF;
@@ -187,7 +197,74 @@ void SystemClock_Config(void)
 }
 
 /* USER CODE BEGIN 4 */
+static ch9141_ErrorStatus_t Shaper_Transmit(uint8_t const *pData, uint16_t size, void *context)
+{
+    return (CH9141_TxQueue(pData, size, Shaper_Done, context) == SUCCESS) ? CH9141_ERROR_STATUS_SUCCESS
+                                                                          : CH9141_ERROR_STATUS_ERROR;
+}
+
+static void Shaper_Done(void const *pData, uint16_t size, void *context, bool ok)
+{
+    CH9141_SHAPER_TxDone(&shaper);
+}
+
+static void Verb_LedRed(int32_t const *args, uint8_t argc, void *context)
+{
+    LEDR_ON, LEDG_OFF, LEDB_OFF;
+    CH9141_SHAPER_Write(&shaper, "OK Red", 6);
+}
+
+static void Verb_LedGreen(int32_t const *args, uint8_t argc, void *context)
+{
+    LEDR_OFF, LEDG_ON, LEDB_OFF;
+    CH9141_SHAPER_Write(&shaper, "OK Green", 8);
+}
 
+static void Verb_LedBlue(int32_t const *args, uint8_t argc, void *context)
+{
+    LEDR_OFF, LEDG_OFF, LEDB_ON;
+    CH9141_SHAPER_Write(&shaper, "OK Blue", 7);
+}
+
+static void Verb_Disable(int32_t const *args, uint8_t argc, void *context)
+{
+    LEDR_OFF, LEDG_OFF, LEDB_OFF;
+    CH9141_SHAPER_Write(&shaper, "OK Disable", 10);
+}
+
+static void Verb_PowerOff(int32_t const *args, uint8_t argc, void *context)
+{
+    uint32_t start = HAL_GetTick();
+
+    /* Paced reply may need more than a single pass */
+    CH9141_SHAPER_Write(&shaper, "OK Power Off", 12);
+    CH9141_SHAPER_Flush(&shaper);
+    while (((shaper.readyNum != 0) || (shaper.sentNum != 0)) && (HAL_GetTick() - start < POWER_OFF_DRAIN_TIMEOUT))
+        CH9141_SHAPER_Process(&shaper);
+    HAL_Delay(3000);
+    PWR_OFF;
+}
+
+static void Verb_Status(int32_t const *args, uint8_t argc, void *context)
+{
+    if (CH9141_AtSubmit(Job_Status, NULL) == ERROR)
+        CH9141_SHAPER_Write(&shaper, "ERR Busy", 8);
+}
+
+static void Job_Status(ch9141_t *ble, void *context)
+{
+    char reply[] = "OK Status 0";
+    ch9141_BLEStatus_t status = CH9141_StatusGet(ble);
+
+    if (ble->error != CH9141_ERR_NONE)
+    {
+        CH9141_SHAPER_Write(&shaper, "ERR Status", 10);
+        return;
+    }
+
+    reply[10] += (char) status;
+    CH9141_SHAPER_Write(&shaper, reply, sizeof(reply) - 1);
+}
 /* USER CODE END 4 */
 
 /**
@@ -57,6 +57,8 @@
 /* External variables --------------------------------------------------------*/
 extern UART_HandleTypeDef huart4;
 /* USER CODE BEGIN EV */
+extern DMA_HandleTypeDef hdma_uart4_rx;
+extern DMA_HandleTypeDef hdma_uart4_tx;
 
 /* USER CODE END EV */
 
@@ -213,5 +215,19 @@ void UART4_IRQHandler(void)
 }
 
 /* USER CODE BEGIN 1 */
+/**
+  * @brief This function handles DMA1 stream2 global interrupt.
+  */
+void DMA1_Stream2_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_uart4_rx);
+}
 
+/**
+  * @brief This function handles DMA1 stream4 global interrupt.
+  */
+void DMA1_Stream4_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_uart4_tx);
+}
 /* USER CODE END 1 */